@@ -1,33 +1,477 @@
-#include "PCB.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-static int  PIDcount = 0;
-
-// Creates a new PCB with given priority, returns pointer to new PCB or NULL if failed
-PCB* PCB_create(int priority){
-    PCB* new_PCB = malloc(sizeof(PCB));
-    if (new_PCB == NULL){
-        return NULL;
-    }
-
-    new_PCB->PID = PIDcount;
-    PIDcount++;
-    new_PCB->priority = priority;
-    new_PCB->pState = READY;
-    memset(new_PCB->recv_msg, '\0', MAX_MSG);
-    new_PCB->senderPID = -1;
-    memset(new_PCB->send_msg, '\0', MAX_PROCESS_MSG);
-    return new_PCB;
-}
-
-// Frees the memory allocated for the PCB
-void PCB_free(PCB* process){
-    if (process == NULL){
-        printf("ERROR: Failed to delete process, process is NULL.\n");
-        return;
-    }
-    free(process);
-    process = NULL; 
-}
\ No newline at end of file
+#include "PCB.h"
+#include "cgroup.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int  PIDcount = 0;
+
+// Fixed-size items carved out of heap chunks of PCB_POOL_CHUNK items, freed items go on a free list
+// and are handed out again before the pool grows
+struct Pool{
+    size_t itemSize;    // Rounded up so that every item can hold the free list link
+    void* freeItems;    // Each free item starts with a pointer to the next one
+    void* chunks;       // Each chunk starts with a pointer to the next one
+    int inUse;
+    int capacity;
+    int heapAllocs;
+};
+#define POOL_ITEM_SIZE(type) ((sizeof(type) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*))
+#define POOL_HEADER 16  // Keeps the items of a chunk aligned for any member type
+
+static struct Pool pcbPool = {POOL_ITEM_SIZE(PCB)};
+static struct Pool coldPool = {POOL_ITEM_SIZE(PCB_cold)};
+static struct Pool msgsPool = {POOL_ITEM_SIZE(PCB_msgs)};
+static struct Pool syncPool = {POOL_ITEM_SIZE(PCB_sync)};
+static struct Pool dlPool = {POOL_ITEM_SIZE(PCB_dl)};
+static struct Pool waitPool = {POOL_ITEM_SIZE(Waitq_node)};
+// Empty buffers of every process that has not written any. They are not counted as shared, a
+// refCount of 0 tells them apart from buffers taken from the pool
+static PCB_msgs noMsgs;
+// Cold part of every process that has not needed one of its own, never written
+static PCB_cold noCold = {
+    .lastRan = -1, .msgs = &noMsgs, .groupID = -1, .senderPID = -1, .chanID = -1, .topicID = -1
+};
+
+// Live PCBs by PID, open addressing with linear probing, at most three quarters full
+static PCB** pidTable = NULL;
+static int pidCapacity = 0;
+static int pidCount = 0;
+
+static unsigned int pid_slot(int pid){
+    return ((unsigned int)pid * 2654435761u) & (pidCapacity - 1);
+}
+
+// Grows the PID table to capacity slots and rehashes every live PCB into it
+static bool pid_rehash(int capacity){
+    PCB** table = calloc(capacity, sizeof(PCB*));
+    if (table == NULL){
+        return false;
+    }
+    PCB** old = pidTable;
+    int oldCapacity = pidCapacity;
+    pidTable = table;
+    pidCapacity = capacity;
+    for (int i = 0; i < oldCapacity; i++){
+        if (old[i] != NULL){
+            unsigned int slot = pid_slot(old[i]->PID);
+            while (pidTable[slot] != NULL){
+                slot = (slot + 1) & (pidCapacity - 1);
+            }
+            pidTable[slot] = old[i];
+        }
+    }
+    free(old);
+    return true;
+}
+
+static bool pid_insert(PCB* process){
+    if (4 * (pidCount + 1) > 3 * pidCapacity && !pid_rehash(pidCapacity ? 2 * pidCapacity : 64)){
+        return false;
+    }
+    unsigned int slot = pid_slot(process->PID);
+    while (pidTable[slot] != NULL){
+        slot = (slot + 1) & (pidCapacity - 1);
+    }
+    pidTable[slot] = process;
+    pidCount++;
+    return true;
+}
+
+// Removes process, shifting later entries of its probe run back so that no tombstones are needed
+static void pid_remove(PCB* process){
+    if (pidCapacity == 0){
+        return;
+    }
+    unsigned int slot = pid_slot(process->PID);
+    while (pidTable[slot] != NULL && pidTable[slot] != process){
+        slot = (slot + 1) & (pidCapacity - 1);
+    }
+    if (pidTable[slot] == NULL){
+        return;
+    }
+    pidTable[slot] = NULL;
+    pidCount--;
+    unsigned int next = (slot + 1) & (pidCapacity - 1);
+    while (pidTable[next] != NULL){
+        unsigned int home = pid_slot(pidTable[next]->PID);
+        // Move the entry into the hole unless its home lies cyclically in (slot, next]
+        if ((next > slot && (home <= slot || home > next)) || (next < slot && home <= slot && home > next)){
+            pidTable[slot] = pidTable[next];
+            pidTable[next] = NULL;
+            slot = next;
+        }
+        next = (next + 1) & (pidCapacity - 1);
+    }
+}
+
+// Takes an item from the pool, growing it by a chunk if it is empty. Returns NULL if out of memory
+static void* pool_get(struct Pool* pool){
+    if (pool->freeItems == NULL){
+        char* chunk = malloc(POOL_HEADER + PCB_POOL_CHUNK * pool->itemSize);
+        if (chunk == NULL){
+            return NULL;
+        }
+        pool->heapAllocs++;
+        *(void**)chunk = pool->chunks;
+        pool->chunks = chunk;
+        // Link the new items so that they are handed out in address order
+        for (int i = PCB_POOL_CHUNK - 1; i >= 0; i--){
+            void* item = chunk + POOL_HEADER + i * pool->itemSize;
+            *(void**)item = pool->freeItems;
+            pool->freeItems = item;
+        }
+        pool->capacity += PCB_POOL_CHUNK;
+    }
+    void* item = pool->freeItems;
+    pool->freeItems = *(void**)item;
+    pool->inUse++;
+    return item;
+}
+
+static void pool_put(struct Pool* pool, void* item){
+    *(void**)item = pool->freeItems;
+    pool->freeItems = item;
+    pool->inUse--;
+}
+
+static void pool_release(struct Pool* pool){
+    while (pool->chunks != NULL){
+        void* next = *(void**)pool->chunks;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+    pool->freeItems = NULL;
+    pool->inUse = 0;
+    pool->capacity = 0;
+}
+
+// Allocates a PCB with a new PID that reads the shared cold defaults
+static PCB* PCB_alloc(int priority){
+    PCB* new_PCB = pool_get(&pcbPool);
+    if (new_PCB == NULL){
+        return NULL;
+    }
+
+    new_PCB->PID = PIDcount;
+    if (!pid_insert(new_PCB)){
+        pool_put(&pcbPool, new_PCB);
+        return NULL;
+    }
+    PIDcount++;
+    new_PCB->priority = priority;
+    new_PCB->boostedFrom = -1;
+    new_PCB->pState = READY;
+    new_PCB->queue = PCB_NO_QUEUE;
+    new_PCB->snapQueue = PCB_NOT_SNAPPED;
+    new_PCB->snapChanged = false;
+    new_PCB->queueNode = NULL;
+    new_PCB->readySince = -1;
+    new_PCB->starving = false;
+    new_PCB->policy = POLICY_NORMAL;
+    new_PCB->rtPriority = 0;
+    new_PCB->cgroup = CG_ROOT;
+    new_PCB->suspended = false;
+    new_PCB->cold = &noCold;    // New processes lead their own group and have no parent linked
+    return new_PCB;
+}
+
+// Creates a new PCB with given priority, returns pointer to new PCB or NULL if failed
+PCB* PCB_create(int priority){
+    return PCB_alloc(priority);    // Buffers are only taken from the pool once a message is written
+}
+
+// Creates a copy of parent that shares its message buffers and address space copy-on-write
+PCB* PCB_fork(PCB* parent){
+    PCB* new_PCB = PCB_alloc(parent->priority);
+    if (new_PCB == NULL){
+        return NULL;
+    }
+    PCB_cold* cold = PCB_write_cold(new_PCB);   // Linked under its parent
+    if (cold == NULL){
+        pid_remove(new_PCB);
+        pool_put(&pcbPool, new_PCB);
+        return NULL;
+    }
+    cold->senderPID = parent->cold->senderPID;
+    new_PCB->boostedFrom = parent->boostedFrom; // A boosted parent's child is lowered with it
+    if (parent->cold->burst != NULL){ // Child carries on with the rest of the parent's workload
+        cold->burst = Burst_copy(parent->cold->burst);
+        if (cold->burst == NULL){
+            pool_put(&coldPool, cold);
+            pid_remove(new_PCB);
+            pool_put(&pcbPool, new_PCB);
+            return NULL;
+        }
+        cold->burstLeft = parent->cold->burstLeft;
+    }
+    cold->msgs = parent->cold->msgs;
+    if (cold->msgs->refCount > 0){
+        cold->msgs->refCount++;
+    }
+    cold->mm = Mem_space_share(parent->cold->mm);
+    return new_PCB;
+}
+
+// Returns the cold part of process for writing, taking it from its pool first if it reads the defaults
+PCB_cold* PCB_write_cold(PCB* process){
+    if (process->cold != &noCold){
+        return process->cold;
+    }
+    PCB_cold* cold = pool_get(&coldPool);
+    if (cold == NULL){
+        return NULL;
+    }
+    *cold = noCold;
+    process->cold = cold;
+    return cold;
+}
+
+// Returns the message buffers of process for writing, copying them first if they are shared
+PCB_msgs* PCB_write_msgs(PCB* process){
+    if (process->cold->msgs->refCount == 1){
+        return process->cold->msgs;
+    }
+    PCB_cold* cold = PCB_write_cold(process);
+    PCB_msgs* copy = cold ? pool_get(&msgsPool) : NULL;
+    if (copy == NULL){
+        return NULL;
+    }
+    memcpy(copy, cold->msgs, sizeof(PCB_msgs));
+    copy->refCount = 1;
+    if (cold->msgs->refCount > 0){
+        cold->msgs->refCount--;
+    }
+    cold->msgs = copy;
+    return copy;
+}
+
+// Returns the blocking state of process, taking it from its pool on first use
+PCB_sync* PCB_get_sync(PCB* process){
+    if (process->cold->sync == NULL){
+        PCB_cold* cold = PCB_write_cold(process);
+        PCB_sync* sync = cold ? pool_get(&syncPool) : NULL;
+        if (sync == NULL){
+            return NULL;
+        }
+        Wfg_init(&sync->wait, WFG_PROCESS, process->PID);
+        memset(sync->semHeld, 0, sizeof(sync->semHeld));
+        cold->sync = sync;
+    }
+    return process->cold->sync;
+}
+
+// Returns the deadline reservation of process, taking it from its pool on first use
+PCB_dl* PCB_get_dl(PCB* process){
+    if (process->cold->dl == NULL){
+        PCB_cold* cold = PCB_write_cold(process);
+        PCB_dl* dl = cold ? pool_get(&dlPool) : NULL;
+        if (dl == NULL){
+            return NULL;
+        }
+        memset(dl, 0, sizeof(PCB_dl));
+        cold->dl = dl;
+    }
+    return process->cold->dl;
+}
+
+// Returns the ready wait node of process, taking it from its pool on first use
+Waitq_node* PCB_get_ready_wait(PCB* process){
+    if (process->cold->readyWait == NULL){
+        PCB_cold* cold = PCB_write_cold(process);
+        Waitq_node* node = cold ? pool_get(&waitPool) : NULL;
+        if (node == NULL){
+            return NULL;
+        }
+        node->pos = NULL;   // pos is the Waitq of the ready level the process waits on
+        cold->readyWait = node;
+    }
+    return process->cold->readyWait;
+}
+
+// Returns the process group of process, a process leads its own until it joins another
+int PCB_group(PCB* process){
+    return process->cold->groupID >= 0 ? process->cold->groupID : process->PID;
+}
+
+// Returns the number of bytes used by process, shared buffers and address spaces are split evenly between sharers
+int PCB_memory(PCB* process, int* privateBytes){
+    PCB_cold* cold = process->cold;
+    int own = sizeof(PCB) + (cold != &noCold ? sizeof(PCB_cold) : 0) + (cold->sync ? sizeof(PCB_sync) : 0) +
+        (cold->dl ? sizeof(PCB_dl) : 0) + (cold->readyWait ? sizeof(Waitq_node) : 0);
+    int shared = 0;
+    if (cold->msgs->refCount == 1){  // refCount 0 means no buffers of its own yet
+        own += sizeof(PCB_msgs);
+    } else if (cold->msgs->refCount > 1){
+        shared += sizeof(PCB_msgs) / cold->msgs->refCount;
+    }
+    if (cold->mm != NULL && cold->mm->refCount == 1){
+        own += Mem_space_bytes(cold->mm);
+    } else if (cold->mm != NULL){
+        shared += Mem_space_bytes(cold->mm) / cold->mm->refCount;
+    }
+    if (privateBytes != NULL){
+        *privateBytes = own;
+    }
+    return own + shared;
+}
+
+// Returns the PCB and its message buffers to their pools
+void PCB_free(PCB* process){
+    if (process == NULL){
+        printf("ERROR: Failed to delete process, process is NULL.\n");
+        return;
+    }
+    PCB_remove_child(process);
+    PCB_cold* cold = process->cold;
+    if (cold != &noCold){   // The defaults hold no parts
+        Mem_space_free(cold->mm);
+        Burst_free(cold->burst);
+        if (cold->sync != NULL){
+            pool_put(&syncPool, cold->sync);
+        }
+        if (cold->dl != NULL){
+            pool_put(&dlPool, cold->dl);
+        }
+        if (cold->readyWait != NULL){
+            pool_put(&waitPool, cold->readyWait);
+        }
+        if (cold->msgs->refCount > 0 && --cold->msgs->refCount == 0){
+            pool_put(&msgsPool, cold->msgs);
+        }
+        pool_put(&coldPool, cold);
+    }
+    pid_remove(process);
+    pool_put(&pcbPool, process);
+    process = NULL; 
+}
+
+// Gives the memory of every PCB, its parts and message buffers back to the heap
+void PCB_pool_free(){
+    free(pidTable);
+    pidTable = NULL;
+    pidCapacity = pidCount = 0;
+    pool_release(&pcbPool);
+    pool_release(&coldPool);
+    pool_release(&msgsPool);
+    pool_release(&syncPool);
+    pool_release(&dlPool);
+    pool_release(&waitPool);
+}
+
+// Prints the use and heap allocations of the PCB, PCB part and message buffer pools
+void PCB_print_stats(){
+    printf("PCB pool: %d of %d in use (%d bytes each), cold parts: %d of %d in use (%d bytes each), "
+        "blocking state: %d of %d in use (%d bytes each), deadline reservations: %d of %d in use, "
+        "ready waits: %d of %d in use, message buffers: %d of %d in use, %d heap allocation(s)\n",
+        pcbPool.inUse, pcbPool.capacity, (int)sizeof(PCB), coldPool.inUse, coldPool.capacity, (int)sizeof(PCB_cold),
+        syncPool.inUse, syncPool.capacity, (int)sizeof(PCB_sync), dlPool.inUse, dlPool.capacity,
+        waitPool.inUse, waitPool.capacity, msgsPool.inUse, msgsPool.capacity, PCB_heap_allocs());
+}
+
+// Returns the number of heap allocations made by the pools
+int PCB_heap_allocs(){
+    return pcbPool.heapAllocs + coldPool.heapAllocs + msgsPool.heapAllocs + syncPool.heapAllocs + dlPool.heapAllocs +
+        waitPool.heapAllocs;
+}
+
+// Returns the live PCB with the given PID
+PCB* PCB_find(int pid){
+    if (pidCapacity == 0){
+        return NULL;
+    }
+    unsigned int slot = pid_slot(pid);
+    while (pidTable[slot] != NULL){
+        if (pidTable[slot]->PID == pid){
+            return pidTable[slot];
+        }
+        slot = (slot + 1) & (pidCapacity - 1);
+    }
+    return NULL;
+}
+
+// Returns the number of live PCBs, init and zombies included
+int PCB_count(){
+    return pidCount;
+}
+
+// Links child at the front of parent's children list, both own their cold part
+void PCB_add_child(PCB* parent, PCB* child){
+    child->cold->parent = parent;
+    child->cold->prevSibling = NULL;
+    child->cold->nextSibling = parent->cold->firstChild;
+    if (parent->cold->firstChild != NULL){
+        parent->cold->firstChild->cold->prevSibling = child;
+    }
+    parent->cold->firstChild = child;
+}
+
+// Unlinks process from its parent's children or zombie list
+void PCB_remove_child(PCB* process){
+    PCB* parent = process->cold->parent;
+    if (parent == NULL){    // Also the case for every process still reading the defaults
+        return;
+    }
+    PCB_cold* cold = process->cold;
+    if (cold->prevSibling != NULL){
+        cold->prevSibling->cold->nextSibling = cold->nextSibling;
+    } else if (parent->cold->firstChild == process){
+        parent->cold->firstChild = cold->nextSibling;
+    } else if (parent->cold->firstZombie == process){
+        parent->cold->firstZombie = cold->nextSibling;
+    }
+    if (cold->nextSibling != NULL){
+        cold->nextSibling->cold->prevSibling = cold->prevSibling;
+    }
+    cold->parent = NULL;
+    cold->nextSibling = NULL;
+    cold->prevSibling = NULL;
+}
+
+// Moves process from its parent's children list to the zombie list and marks it ZOMBIE
+void PCB_make_zombie(PCB* process){
+    PCB* parent = process->cold->parent;
+    PCB_remove_child(process);
+    process->cold->parent = parent;
+    process->pState = ZOMBIE;
+    process->cold->nextSibling = parent->cold->firstZombie;
+    if (parent->cold->firstZombie != NULL){
+        parent->cold->firstZombie->cold->prevSibling = process;
+    }
+    parent->cold->firstZombie = process;
+}
+
+// Unlinks and returns the first zombie child of parent, or NULL if it has none
+PCB* PCB_reap(PCB* parent){
+    PCB* zombie = parent->cold->firstZombie;
+    if (zombie != NULL){
+        PCB_remove_child(zombie);
+    }
+    return zombie;
+}
+
+// Moves all live children of process under newParent, or unlinks them if newParent is NULL
+void PCB_reparent(PCB* process, PCB* newParent){
+    PCB* child = process->cold->firstChild;
+    if (child == NULL){
+        return;
+    }
+    if (newParent == NULL){
+        while ((child = process->cold->firstChild) != NULL){
+            PCB_remove_child(child);
+        }
+        return;
+    }
+    PCB* last = NULL;
+    for (; child != NULL; child = child->cold->nextSibling){
+        child->cold->parent = newParent;
+        last = child;
+    }
+    // Splice the whole sibling list in front of newParent's children
+    last->cold->nextSibling = newParent->cold->firstChild;
+    if (newParent->cold->firstChild != NULL){
+        newParent->cold->firstChild->cold->prevSibling = last;
+    }
+    newParent->cold->firstChild = process->cold->firstChild;
+    process->cold->firstChild = NULL;
+}
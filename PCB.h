@@ -1,32 +1,181 @@
-// Processor Control Block (PCB) header file
-#ifndef _PCB_H_
-#define _PCB_H_
-#include <stdbool.h>
-
-#define MAX_MSG 100
-#define MAX_PROCESS_MSG 100
-
-enum process_state{
-    RUNNING, READY, BLOCKED
-};
-
-enum process_priority{ // Process priority levels
-    LOW, MED, HIGH
-};
-
-struct PCB{
-	int PID;    // Process ID
-    int priority;   // Process priority
-	int pState;  // Process state
-    char recv_msg[MAX_MSG]; // Message received from other process
-    int senderPID;   // PID of process that sent the message
-    char send_msg[MAX_PROCESS_MSG]; // Message to be sent to other process
-}; typedef struct PCB PCB;
-
-// Creates a new PCB with given priority, returns pointer to new PCB or NULL if failed
-PCB* PCB_create(int priority);
-
-// Frees the memory allocated for the PCB
-void PCB_free(PCB* process);
-
+// Processor Control Block (PCB) header file
+#ifndef _PCB_H_
+#define _PCB_H_
+#include <stdbool.h>
+#include <stdint.h>
+#include "memory.h"
+#include "burst.h"
+#include "waitgraph.h"
+#include "waitq.h"
+
+#define MAX_MSG 100
+#define MAX_PROCESS_MSG 100
+#define PCB_NO_QUEUE -1
+#define PCB_NOT_SNAPPED -2
+#define PCB_MAX_SEMS 5     // Semaphores a process can hold units of
+#define PCB_POOL_CHUNK 1024 // PCBs and message buffers are taken from the heap this many at a time
+
+enum process_state{
+    RUNNING, READY, BLOCKED, ZOMBIE
+};
+
+enum process_priority{ // Process priority levels
+    LOW, MED, HIGH
+};
+
+// Scheduling classes, deadline processes run before real-time ones and both run before normal ones
+enum sched_policy{
+    POLICY_NORMAL,  // Three priority levels with round robin in each
+    POLICY_FIFO,    // Real-time, runs until it blocks or yields
+    POLICY_RR,      // Real-time, round robin between processes of the same real-time priority
+    POLICY_DEADLINE // Earliest deadline first with a runtime reservation in every period
+};
+
+#define RT_MIN_PRIORITY 1
+#define RT_MAX_PRIORITY 99
+
+// Message buffers of a process, shared copy-on-write between a forked child and its parent
+struct PCB_msgs{
+    int refCount;   // Number of processes sharing these buffers
+    char recv_msg[MAX_MSG]; // Message received from other process
+    char send_msg[MAX_PROCESS_MSG]; // Message to be sent to other process
+}; typedef struct PCB_msgs PCB_msgs;
+
+// Blocking state, taken from its pool the first time a process waits on or holds something. Most
+// processes never need it, so it is kept out of the PCB
+struct PCB_sync{
+    Wfg_node wait;  // Node in the wait-for graph, has an edge while blocked on a reply or semaphore
+    Waitq_node semWait; // Place in the wait order of the semaphore a blocked process waits on
+    uint16_t semHeld[PCB_MAX_SEMS]; // Units of each semaphore the process holds (P() done, V() not yet)
+}; typedef struct PCB_sync PCB_sync;
+
+// Runtime reservation of a deadline process, taken from its pool when the process is created
+struct PCB_dl{
+    long runtime;   // Runtime reserved in every period
+    long deadline;  // Deadline relative to the start of a period
+    long period;
+    long budget;    // Runtime left in the current reservation, the process is throttled once it runs out
+    long absDeadline;   // Absolute deadline of the current reservation
+    int misses;     // Deadlines that passed while the process still had runtime left
+}; typedef struct PCB_dl PCB_dl;
+
+// Rarely touched state of a process. A process reads the shared defaults until it first needs a
+// part of its own, so one that only waits on a ready queue has none. Running, forking, blocking,
+// messaging and setting a workload or reservation are what take one from the pool
+struct PCB_cold{
+    long cpuTime;   // Ticks the process has run for
+    long lastRan;   // Time the process last held the CPU, -1 if it has never run
+    long maxWait;   // Longest time the process waited ready before being dispatched
+    long burstLeft; // CPU time left in the current burst
+    long wakeTime;  // Time at which a process blocked on a timed event (page fault, sleep) is readied
+    Burst* burst;   // Workload model, NULL for processes driven only by commands
+    PCB_msgs* msgs; // Read through msgs, write through PCB_write_msgs(). Shared empty buffers until first written
+    Mem_space* mm;  // Simulated address space, created on the first memory access
+    PCB_sync* sync; // NULL until the process first waits on or holds something
+    PCB_dl* dl;     // Deadline processes only, NULL for every other class
+    Waitq_node* readyWait;  // Place among the waiters of its ready level while starvation alarms are on
+    // Process tree, children and zombies are kept in intrusive sibling lists. Children of init are
+    // not linked, init reaps them straight away and never waits for one
+    struct PCB* parent;         // Forking process, NULL for init and its children
+    struct PCB* firstChild;     // Live children
+    struct PCB* firstZombie;    // Exited children waiting to be reaped
+    struct PCB* nextSibling;
+    struct PCB* prevSibling;
+    int groupID;    // Process group, -1 while the process leads its own (see PCB_group())
+    int senderPID;  // PID of process that sent the message
+    int chanID;     // Channel a blocked process waits on, -1 if none
+    int topicID;    // Topic a blocked process waits on for a publication, -1 if none
+    int burstGen;   // Stamp of the process' latest burst completion event, older ones are ignored
+    int8_t burstCarry;  // Hundredths of a tick of burst work done below full speed, not yet taken off burstLeft
+}; typedef struct PCB_cold PCB_cold;
+
+// The PCB holds what the queues and the dispatcher touch for every process, 32 bytes of it, and the
+// handle of its cold part. Small enums are stored in a byte
+struct PCB{
+	int PID;    // Process ID
+    int8_t pState;  // Process state
+    int8_t priority;    // Process priority
+    int8_t policy;  // Scheduling class (enum sched_policy)
+    uint8_t rtPriority; // FIFO and RR processes, a higher real-time priority runs first
+    bool suspended; // Group has been suspended, process is kept off the ready queues
+    bool starving;  // A starvation alarm was raised for the current wait
+    bool snapChanged;   // Recorded as changed since the last snapshot
+    int8_t cgroup;  // Control group the process' runtime is charged to
+    int8_t queue;   // Watched queue the process was last added to, PCB_NO_QUEUE if none
+    int8_t snapQueue;   // Queue at the last snapshot, PCB_NOT_SNAPPED if created since
+    int8_t boostedFrom; // Priority before a boost, restored when the next quantum expires. -1 if not boosted
+    long readySince;    // Time the process last became ready, -1 while it is not waiting to run
+    void* queueNode;    // Node of the process on its watched queue, valid while queue names that queue
+    PCB_cold* cold; // Read through cold, write through PCB_write_cold(). Shared defaults until first written
+}; typedef struct PCB PCB;
+
+// Creates a new PCB with given priority, returns pointer to new PCB or NULL if failed
+PCB* PCB_create(int priority);
+
+// Creates a copy of parent that shares its message buffers and address space copy-on-write
+// Returns pointer to new PCB or NULL if failed
+PCB* PCB_fork(PCB* parent);
+
+// Returns the cold part of process for writing, taking it from its pool first if the process
+// still reads the shared defaults. Returns NULL if it could not be allocated
+PCB_cold* PCB_write_cold(PCB* process);
+
+// Returns the message buffers of process for writing, copying them first if they are shared
+// Returns NULL if the private copy could not be allocated
+PCB_msgs* PCB_write_msgs(PCB* process);
+
+// Returns the blocking state of process, taking it from its pool on first use
+// Returns NULL if it could not be allocated
+PCB_sync* PCB_get_sync(PCB* process);
+
+// Returns the deadline reservation of process, taking it from its pool on first use
+// Returns NULL if it could not be allocated
+PCB_dl* PCB_get_dl(PCB* process);
+
+// Returns the ready wait node of process, taking it from its pool on first use
+// Returns NULL if it could not be allocated
+Waitq_node* PCB_get_ready_wait(PCB* process);
+
+// Returns the process group of process
+int PCB_group(PCB* process);
+
+// Returns the number of bytes used by process and its address space, shared buffers and address
+// spaces are split evenly between sharers. The private part is stored in privateBytes if it is not NULL
+int PCB_memory(PCB* process, int* privateBytes);
+
+// Returns the PCB and its message buffers to their pools, unlinking it from its parent first
+void PCB_free(PCB* process);
+
+// Gives the memory of every PCB, its parts and message buffers back to the heap, all PCBs must be dead
+void PCB_pool_free();
+
+// Prints how many PCBs and message buffers are in use, the pool capacity and the number of heap
+// allocations made for them. Once the pools have grown to the peak process count, creating and
+// exiting processes makes no further heap allocations
+void PCB_print_stats();
+
+// Returns the number of heap allocations made for PCBs, their parts and message buffers so far
+int PCB_heap_allocs();
+
+// Returns the live PCB with the given PID in O(1), including zombies, or NULL if there is none
+PCB* PCB_find(int pid);
+
+// Returns the number of live PCBs, init and zombies included
+int PCB_count();
+
+// Links child at the front of parent's children list, both must have their own cold part
+void PCB_add_child(PCB* parent, PCB* child);
+
+// Unlinks process from its parent's children or zombie list
+void PCB_remove_child(PCB* process);
+
+// Moves process from its parent's children list to the zombie list and marks it ZOMBIE
+void PCB_make_zombie(PCB* process);
+
+// Unlinks and returns the first zombie child of parent, or NULL if it has none
+PCB* PCB_reap(PCB* parent);
+
+// Moves all live children of process under newParent, or unlinks them if newParent is NULL
+void PCB_reparent(PCB* process, PCB* newParent);
+
 #endif
\ No newline at end of file
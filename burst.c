@@ -0,0 +1,94 @@
+#include "burst.h"
+#include "random.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Parses a script of whitespace separated burst lengths (cpu io cpu io ... cpu)
+Burst* Burst_parse(const char* text, int device) {
+    Burst* model = calloc(1, sizeof(Burst));
+    if(model == NULL)
+        return NULL;
+    model->type = BURST_SCRIPT;
+    model->device = device;
+
+    const char* p = text;
+    char* end;
+    while(model->length < BURST_MAX_SCRIPT) {
+        long value = strtol(p, &end, 10);
+        if(end == p)    // No more numbers
+            break;
+        // CPU bursts sit at even positions and must be positive, I/O bursts may be 0 (yield)
+        if(value < 0 || (value == 0 && model->length % 2 == 0)) {
+            free(model);
+            return NULL;
+        }
+        model->script[model->length++] = value;
+        p = end;
+    }
+    while(*p == ' ' || *p == '\t')
+        p++;
+    if(model->length == 0 || *p != '\0') {  // Empty, too long or not a number
+        free(model);
+        return NULL;
+    }
+    if(model->length % 2 == 0)  // Trailing I/O burst has nothing after it
+        model->length--;
+    return model;
+}
+
+// Creates a random model with count CPU bursts
+Burst* Burst_random(long meanCpu, long meanIo, int count, int device) {
+    if(meanCpu < 1 || meanIo < 0 || count < 1)
+        return NULL;
+    Burst* model = calloc(1, sizeof(Burst));
+    if(model == NULL)
+        return NULL;
+    model->type = BURST_RANDOM;
+    model->device = device;
+    model->meanCpu = meanCpu;
+    model->meanIo = meanIo;
+    model->count = count;
+    return model;
+}
+
+// Returns a copy of model at the same position in its workload
+Burst* Burst_copy(Burst* model) {
+    Burst* copy = malloc(sizeof(Burst));
+    if(copy == NULL)
+        return NULL;
+    memcpy(copy, model, sizeof(Burst));
+    return copy;
+}
+
+// Restarts model and returns the length of its first CPU burst
+long Burst_first(Burst* model) {
+    if(model->type == BURST_SCRIPT) {
+        model->next = 1;
+        return model->script[0];
+    }
+    model->remaining = model->count - 1;
+    return Random_exponential(model->meanCpu);
+}
+
+// Called when a CPU burst ends, stores the following I/O and CPU bursts
+bool Burst_next(Burst* model, long* io, long* cpu) {
+    if(model->type == BURST_SCRIPT) {
+        if(model->next + 1 >= model->length)
+            return false;
+        *io = model->script[model->next];
+        *cpu = model->script[model->next + 1];
+        model->next += 2;
+        return true;
+    }
+    if(model->remaining == 0)
+        return false;
+    model->remaining--;
+    *io = model->meanIo > 0 ? Random_exponential(model->meanIo) : 0;
+    *cpu = Random_exponential(model->meanCpu);
+    return true;
+}
+
+// Frees the model
+void Burst_free(Burst* model) {
+    free(model);
+}
@@ -0,0 +1,51 @@
+// CPU/IO burst model header file
+// A burst model describes the workload of a process as alternating CPU and I/O bursts, either
+// from a fixed script or drawn from exponential distributions
+#ifndef _BURST_H_
+#define _BURST_H_
+#include <stdbool.h>
+
+#define BURST_MAX_SCRIPT 64
+#define BURST_NO_DEVICE -1
+
+enum burst_type{
+    BURST_SCRIPT, BURST_RANDOM
+};
+
+typedef struct Burst_s Burst;
+struct Burst_s{
+    int type;
+    int device;     // Device I/O bursts are issued to, BURST_NO_DEVICE for a plain timed wait
+    // Script: cpu, io, cpu, io, ..., cpu
+    long script[BURST_MAX_SCRIPT];
+    int length;
+    int next;       // Index of the next entry to hand out
+    // Random: exponential bursts with the given means
+    long meanCpu;
+    long meanIo;
+    int count;      // Number of CPU bursts
+    int remaining;  // CPU bursts not yet handed out
+};
+
+// Parses a script of whitespace separated burst lengths (cpu io cpu io ... cpu)
+// Returns NULL if the script is empty, too long or has a non-positive CPU burst
+Burst* Burst_parse(const char* text, int device);
+
+// Creates a random model with count CPU bursts, returns NULL if the parameters are invalid
+Burst* Burst_random(long meanCpu, long meanIo, int count, int device);
+
+// Returns a copy of model at the same position in its workload, NULL if failed
+Burst* Burst_copy(Burst* model);
+
+// Restarts model and returns the length of its first CPU burst
+long Burst_first(Burst* model);
+
+// Called when a CPU burst ends, stores the following I/O burst in io and the CPU burst after it
+// in cpu. An I/O burst of 0 means the process yields the CPU
+// Returns false if the workload is complete
+bool Burst_next(Burst* model, long* io, long* cpu);
+
+// Frees the model
+void Burst_free(Burst* model);
+
+#endif
@@ -0,0 +1,214 @@
+#include "cgroup.h"
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+struct Cgroup_s{
+    bool used;
+    char name[CG_MAX_NAME];
+    int parent;     // -1 for the root
+    int depth;      // Number of ancestors, used to print the path
+    int weight;
+    long quota;     // Runtime per period, 0 = no limit
+    long period;
+    int epoch;      // Bumped by Cg_set_max(), stale refill timers carry an older one
+    int procs;      // Member processes, not counting those of child groups
+    int runnable;   // Members that are ready or running, not counting those of child groups
+    int active;     // Runnable processes in the group and all groups below it
+    long usage;     // Runtime used in the current period
+    bool throttled;
+    long throttledSince;
+    // Statistics
+    long totalUsage;
+    int throttles;
+    long throttledTime;
+}; typedef struct Cgroup_s Cgroup;
+
+static Cgroup groups[CG_MAX_GROUPS];
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static bool valid(int id) {
+    return id >= 0 && id < CG_MAX_GROUPS && groups[id].used;
+}
+
+static void init_group(Cgroup* group, const char* name, int parent, int weight) {
+    memset(group, 0, sizeof(Cgroup));
+    group->used = true;
+    strcpy(group->name, name);
+    group->parent = parent;
+    group->depth = parent < 0 ? 0 : groups[parent].depth + 1;
+    group->weight = weight;
+}
+
+// Returns the total weight of the runnable members and active child groups of group id
+static long runnable_weight(int id) {
+    long total = (long)groups[id].runnable * CG_DEFAULT_WEIGHT;
+    for(int i = 0; i < CG_MAX_GROUPS; i++) {
+        if(groups[i].used && groups[i].parent == id && groups[i].active > 0)
+            total += groups[i].weight;
+    }
+    return total;
+}
+
+// Prints the groups below id in depth-first order
+static void print_tree(int id) {
+    Cgroup* group = &groups[id];
+    printf("Cgroup %*s%s: weight %d", 2 * group->depth, "", group->name, group->weight);
+    if(group->quota > 0)
+        printf(", max %ld/%ld", group->quota, group->period);
+    printf(", %d process(es), %ld tick(s) used", group->procs, group->totalUsage);
+    if(group->throttles > 0)
+        printf(", throttled %d time(s) for %ld tick(s)%s", group->throttles, group->throttledTime,
+            group->throttled ? " (now throttled)" : "");
+    printf("\n");
+    for(int i = 0; i < CG_MAX_GROUPS; i++) {
+        if(groups[i].used && groups[i].parent == id)
+            print_tree(i);
+    }
+}
+
+// ---------------------------------------- Cgroup functions --------------------------------------
+
+void Cg_reset() {
+    memset(groups, 0, sizeof(groups));
+    init_group(&groups[CG_ROOT], "/", -1, CG_DEFAULT_WEIGHT);
+}
+
+int Cg_create(const char* name, int parent, int weight) {
+    if(!valid(parent) || weight < 1 || weight > CG_MAX_WEIGHT)
+        return CG_FAIL;
+    if(name[0] == '\0' || strlen(name) >= CG_MAX_NAME || Cg_find(name) != CG_FAIL)
+        return CG_FAIL;
+    for(int i = 0; i < CG_MAX_GROUPS; i++) {
+        if(!groups[i].used) {
+            init_group(&groups[i], name, parent, weight);
+            return i;
+        }
+    }
+    return CG_FAIL;
+}
+
+int Cg_find(const char* name) {
+    for(int i = 0; i < CG_MAX_GROUPS; i++) {
+        if(groups[i].used && strcmp(groups[i].name, name) == 0)
+            return i;
+    }
+    return CG_FAIL;
+}
+
+const char* Cg_name(int id) {
+    return valid(id) ? groups[id].name : "";
+}
+
+int Cg_set_max(int id, long quota, long period, long now) {
+    if(!valid(id) || quota < 0 || (quota > 0 && period < 1))
+        return CG_FAIL;
+    Cgroup* group = &groups[id];
+    if(group->throttled)
+        group->throttledTime += now - group->throttledSince;
+    group->quota = quota;
+    group->period = quota > 0 ? period : 0;
+    group->epoch++; // The old refill timer dies off
+    group->usage = 0;
+    group->throttled = false;
+    if(quota == 0)
+        return CG_SUCCESS;
+    return id + CG_MAX_GROUPS * group->epoch;
+}
+
+long Cg_refill(int timer, long now) {
+    int id = timer % CG_MAX_GROUPS;
+    Cgroup* group = &groups[id];
+    if(!valid(id) || group->quota == 0 || timer / CG_MAX_GROUPS != group->epoch)
+        return 0;
+    if(group->throttled)
+        group->throttledTime += now - group->throttledSince;
+    group->usage = 0;
+    group->throttled = false;
+    return group->period;
+}
+
+void Cg_cancel(int timer, long now) {
+    int id = timer % CG_MAX_GROUPS;
+    if(valid(id) && timer / CG_MAX_GROUPS == groups[id].epoch)
+        Cg_set_max(id, 0, 0, now);
+}
+
+void Cg_attach(int id) {
+    if(valid(id))
+        groups[id].procs++;
+}
+
+void Cg_detach(int id) {
+    if(valid(id))
+        groups[id].procs--;
+}
+
+void Cg_runnable(int id, int delta) {
+    if(!valid(id))
+        return;
+    groups[id].runnable += delta;
+    for(; valid(id); id = groups[id].parent)
+        groups[id].active += delta;
+}
+
+void Cg_charge(int id, long ran, long now) {
+    for(; valid(id); id = groups[id].parent) {
+        Cgroup* group = &groups[id];
+        group->usage += ran;
+        group->totalUsage += ran;
+        if(group->quota > 0 && group->usage >= group->quota && !group->throttled) {
+            group->throttled = true;
+            group->throttledSince = now;
+            group->throttles++;
+        }
+    }
+}
+
+bool Cg_throttled(int id) {
+    for(; valid(id); id = groups[id].parent) {
+        if(groups[id].throttled)
+            return true;
+    }
+    return false;
+}
+
+long Cg_runtime_left(int id) {
+    long left = LONG_MAX;
+    for(; valid(id); id = groups[id].parent) {
+        if(groups[id].quota > 0 && groups[id].quota - groups[id].usage < left)
+            left = groups[id].quota - groups[id].usage;
+    }
+    return left;
+}
+
+long Cg_scale(int id, long slice) {
+    if(slice == LONG_MAX || !valid(id) || id == CG_ROOT)
+        return slice;
+    // A top level group's round is its weight's worth of slice, each group below splits its round
+    // between its runnable members and active child groups by weight
+    double scaled = slice;
+    int child = CG_FAIL;
+    for(int group = id; valid(group); child = group, group = groups[group].parent) {
+        long total = runnable_weight(group);
+        if(child == CG_FAIL)    // The process itself, one member's worth
+            scaled = total > 0 ? scaled * CG_DEFAULT_WEIGHT / total : scaled;
+        else if(group != CG_ROOT)
+            scaled = total > 0 ? scaled * groups[child].weight / total : scaled;
+        else
+            scaled = scaled * groups[child].weight / CG_DEFAULT_WEIGHT;
+    }
+    if(scaled >= LONG_MAX / 2)
+        return LONG_MAX / 2;
+    return scaled < 1 ? 1 : (long)scaled;
+}
+
+void Cg_print_stats() {
+    for(int i = 0; i < CG_MAX_GROUPS; i++) {
+        if(i != CG_ROOT && groups[i].used) {    // Nothing to show until a group is created
+            print_tree(CG_ROOT);
+            return;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// Control group header file
+// Groups form a tree under the root group "/", which every process starts in. Each group has a
+// weight and may have a quota of CPU time per period, in the style of cpu.max. A group's members
+// take turns on the ready queues like any other process, but between them they get one slice scaled
+// by the group's weight per round, split between its runnable members and child groups by weight
+// (a member process counts as weight CG_DEFAULT_WEIGHT). Members of the root group get a full slice
+// each, so a busy group gets weight/CG_DEFAULT_WEIGHT times the CPU of a root process however many
+// members it has. Runtime is charged to a group and all of its
+// ancestors, and a group that uses up its quota is throttled until its next period along with
+// every group below it
+#ifndef _CGROUP_H_
+#define _CGROUP_H_
+#include <stdbool.h>
+
+#define CG_MAX_GROUPS 16
+#define CG_MAX_NAME 16
+#define CG_ROOT 0
+#define CG_DEFAULT_WEIGHT 100
+#define CG_MAX_WEIGHT 10000
+#define CG_SUCCESS 0
+#define CG_FAIL -1
+
+// Removes every group but the root and clears its statistics
+void Cg_reset();
+
+// Creates group name under group parent with the given weight (1 to CG_MAX_WEIGHT)
+// Returns the group ID or CG_FAIL (name taken or too long, no such parent, bad weight, no free group)
+int Cg_create(const char* name, int parent, int weight);
+
+// Returns the ID of the group called name, CG_FAIL if there is none
+int Cg_find(const char* name);
+
+// Returns the name of group id
+const char* Cg_name(int id);
+
+// Limits group id to quota ticks of runtime every period ticks from time now, quota 0 = no limit
+// Returns a refill timer for Cg_refill() when the group has a quota, else CG_SUCCESS, or CG_FAIL
+int Cg_set_max(int id, long quota, long period, long now);
+
+// Starts a new period of the group behind timer at time now, unthrottling it
+// Returns the ticks until the timer is due again, 0 if the timer has been replaced or removed
+long Cg_refill(int timer, long now);
+
+// Lifts the limit of the group behind timer at time now, for when its next refill cannot be scheduled
+void Cg_cancel(int timer, long now);
+
+// Counts a process joining or leaving group id
+void Cg_attach(int id);
+void Cg_detach(int id);
+
+// Counts a member of group id becoming runnable (delta 1, ready or running) or no longer runnable (-1)
+void Cg_runnable(int id, int delta);
+
+// Charges ran ticks of runtime to group id and its ancestors at time now
+void Cg_charge(int id, long ran, long now);
+
+// Returns whether group id or any of its ancestors is throttled
+bool Cg_throttled(int id);
+
+// Returns the runtime group id may use before it or an ancestor is throttled, LONG_MAX if unlimited
+long Cg_runtime_left(int id);
+
+// Returns the share of a runnable member of group id in a round of slice ticks, at least 1 tick
+long Cg_scale(int id, long slice);
+
+// Prints the weight, limit, usage and throttling of every group, once any group has been created
+void Cg_print_stats();
+
+#endif
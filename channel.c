@@ -0,0 +1,143 @@
+#include "channel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct Message_s{
+    int sender;
+    char text[CHAN_MAX_MSG];
+}; typedef struct Message_s Message;
+
+struct Channel_s{
+    bool open;
+    char name[CHAN_MAX_NAME];
+    Message* ring;
+    int capacity;
+    int head;       // Oldest message
+    int count;
+    // Statistics
+    long opened;        // Time the channel was opened
+    long lastChange;    // Time count last changed
+    long occupancyArea; // Sum of count over time, for the average occupancy
+    int maxCount;
+    long sent;
+    long received;
+    long direct;        // Handed straight to a waiting receiver
+    long blockedSends;  // Sends that found the channel full
+}; typedef struct Channel_s Channel;
+
+static Channel channels[CHAN_MAX_CHANNELS];
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// Adds the occupancy since the last change to the running total
+static void accumulate(Channel* chan, long now) {
+    chan->occupancyArea += (long)chan->count * (now - chan->lastChange);
+    chan->lastChange = now;
+}
+
+// --------------------------------------- Channel functions --------------------------------------
+
+// Opens a channel called name holding up to capacity messages
+int Chan_open(const char* name, int capacity, long now) {
+    if(capacity < 1 || strlen(name) >= CHAN_MAX_NAME || Chan_find(name) != CHAN_FAIL)
+        return CHAN_FAIL;
+    for(int id = 0; id < CHAN_MAX_CHANNELS; id++) {
+        if(channels[id].open)
+            continue;
+        Message* ring = malloc(capacity * sizeof(Message));
+        if(ring == NULL)
+            return CHAN_FAIL;
+        channels[id] = (Channel){0};
+        channels[id].open = true;
+        strcpy(channels[id].name, name);
+        channels[id].ring = ring;
+        channels[id].capacity = capacity;
+        channels[id].opened = now;
+        channels[id].lastChange = now;
+        return id;
+    }
+    return CHAN_FAIL;
+}
+
+// Returns the ID of the channel called name
+int Chan_find(const char* name) {
+    for(int id = 0; id < CHAN_MAX_CHANNELS; id++) {
+        if(channels[id].open && strcmp(channels[id].name, name) == 0)
+            return id;
+    }
+    return CHAN_FAIL;
+}
+
+const char* Chan_name(int id) {
+    return channels[id].name;
+}
+
+bool Chan_full(int id) {
+    return channels[id].count == channels[id].capacity;
+}
+
+bool Chan_empty(int id) {
+    return channels[id].count == 0;
+}
+
+// Queues a message from sender
+void Chan_push(int id, int sender, const char* msg, long now) {
+    Channel* chan = &channels[id];
+    accumulate(chan, now);
+    Message* slot = &chan->ring[(chan->head + chan->count) % chan->capacity];
+    slot->sender = sender;
+    strncpy(slot->text, msg, CHAN_MAX_MSG - 1);
+    slot->text[CHAN_MAX_MSG - 1] = '\0';
+    chan->count++;
+    if(chan->count > chan->maxCount)
+        chan->maxCount = chan->count;
+    chan->sent++;
+}
+
+// Removes the oldest message and returns its sender
+int Chan_pop(int id, char* msg, long now) {
+    Channel* chan = &channels[id];
+    accumulate(chan, now);
+    Message* slot = &chan->ring[chan->head];
+    strcpy(msg, slot->text);
+    chan->head = (chan->head + 1) % chan->capacity;
+    chan->count--;
+    chan->received++;
+    return slot->sender;
+}
+
+// Counts a message handed straight to a waiting receiver
+void Chan_direct(int id) {
+    channels[id].sent++;
+    channels[id].received++;
+    channels[id].direct++;
+}
+
+// Counts a sender blocked on a full channel
+void Chan_backpressure(int id) {
+    channels[id].blockedSends++;
+}
+
+// Prints occupancy and backpressure statistics of every open channel
+void Chan_print_stats(long now) {
+    for(int id = 0; id < CHAN_MAX_CHANNELS; id++) {
+        Channel* chan = &channels[id];
+        if(!chan->open)
+            continue;
+        accumulate(chan, now);
+        long age = now - chan->opened;
+        printf("Channel %s: %d/%d queued (peak %d, average %.2f), %ld sent, %ld received (%ld direct), "
+            "%ld send(s) blocked on a full buffer\n", chan->name, chan->count, chan->capacity, chan->maxCount,
+            age > 0 ? (double)chan->occupancyArea / age : (double)chan->count, chan->sent, chan->received,
+            chan->direct, chan->blockedSends);
+    }
+}
+
+// Closes every channel and frees the buffers
+void Chan_close_all() {
+    for(int id = 0; id < CHAN_MAX_CHANNELS; id++) {
+        free(channels[id].ring);
+        channels[id] = (Channel){0};
+    }
+}
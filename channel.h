@@ -0,0 +1,45 @@
+// Message channel header file
+// Named channels carry messages between processes through a bounded ring buffer, a sender only
+// has to wait when the buffer is full
+#ifndef _CHANNEL_H_
+#define _CHANNEL_H_
+#include <stdbool.h>
+
+#define CHAN_MAX_CHANNELS 8
+#define CHAN_MAX_NAME 16
+#define CHAN_MAX_MSG 100
+#define CHAN_FAIL -1
+
+// Opens a channel called name holding up to capacity messages
+// Returns the channel ID or CHAN_FAIL (name taken or too long, no free channel, out of memory)
+int Chan_open(const char* name, int capacity, long now);
+
+// Returns the ID of the channel called name, CHAN_FAIL if there is none
+int Chan_find(const char* name);
+
+// Returns the name of channel id
+const char* Chan_name(int id);
+
+bool Chan_full(int id);
+bool Chan_empty(int id);
+
+// Queues a message from sender, the channel must not be full
+void Chan_push(int id, int sender, const char* msg, long now);
+
+// Removes the oldest message into msg (CHAN_MAX_MSG bytes) and returns its sender, the channel
+// must not be empty
+int Chan_pop(int id, char* msg, long now);
+
+// Counts a message handed straight to a waiting receiver without being buffered
+void Chan_direct(int id);
+
+// Counts a sender blocked on a full channel (backpressure)
+void Chan_backpressure(int id);
+
+// Prints occupancy and backpressure statistics of every open channel
+void Chan_print_stats(long now);
+
+// Closes every channel and frees the buffers
+void Chan_close_all();
+
+#endif
@@ -0,0 +1,745 @@
+// Command line front end of the simulator: reads commands and their parameters from the user
+// (or a replay log) and calls the scheduler library, which reports the results
+#include "cli.h"
+#include "commands.h"
+#include "random.h"
+#include "replay.h"
+#include "server.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <limits.h>
+
+static bool inputOpen = true;   // Cleared once the input runs out
+
+int main(int argc, char* argv[]){
+    printf("Booting system...\n");
+    if(argc == 3 && strcmp(argv[1], "--serve") == 0) {  // Driven by clients on a socket instead of stdin
+        start_simulator();
+        int result = Server_run(argv[2]);
+        stop_simulator();
+        printf("Shutting down...\n");
+        return result == SRV_SUCCESS ? 0 : 1;
+    }
+    if(!start_replay(argc, argv))
+        return 1;
+    start_simulator();  // Initialize simulator
+    read_cmd();         // Read user inputs and execute the commands
+    stop_simulator();   // Free all queues and semaphores
+
+    bool replaying = Replay_mode() == REPLAY_REPLAY;
+    long records = Replay_position();
+    if(Replay_close() != REPLAY_SUCCESS) {
+        printf("Error: Replay ended after %ld records, before the end of the recording\n", records);
+        return 1;
+    }
+    if(replaying)
+        printf("Success: Replay matched the recording (%ld records)\n", records);
+    printf("Shutting down...\n");
+    return 0;
+}
+
+void read_cmd() {
+    // Variables for parameters
+    char command;
+    int priority;
+    int pid;
+    int semID = -1;
+    int semVal = -1;
+    int groupID;
+    char groupOp;
+    int vpn;
+    int access;
+    int frames;
+    int policy;
+    int latency;
+    int deviceID;
+    int sector;
+    int devType;
+    int discipline;
+    int distribution;
+    int meanService;
+    int deadline;
+    long length;
+    long meanCpu;
+    long meanIo;
+    long cacheCost;
+    long cacheDecay;
+    long tlbCost;
+    int rtPriority;
+    long runtime;
+    long relDeadline;
+    long period;
+    int count;
+    int stateSpeed[ENERGY_MAX_STATES];
+    int statePower[ENERGY_MAX_STATES];
+    int stateLatency[ENERGY_MAX_STATES];
+    int stateResidency[ENERGY_MAX_STATES];
+    char option;
+    char msg[MAX_MSG];
+    char name[CHAN_MAX_NAME];
+    char parent[CG_MAX_NAME];
+
+    printf("\nCommand List:\n"
+        "\t(C): Create process\n"
+        "\t(F): Fork process\n"
+        "\t(K): Kill process\n"
+        "\t(E): Exit current process\n"
+        "\t(Q): End current time quantum\n"
+        "\t(S): Send message to designated process\n"
+        "\t(R): Receive message\n"
+        "\t(Y): Reply to sender\n"
+        "\t(N): Initialize semaphore\n"
+        "\t(P): Execute semaphore P() operation\n"
+        "\t(V): Execute semaphore V() operation\n"
+        "\t(H): Execute V(n) or broadcast on a semaphore\n"
+        "\t(J): Open, send on or receive from a message channel\n"
+        "\t(Z): Open, subscribe to, publish on or receive from a topic\n"
+        "\t(I): Display complete state info of process\n"
+        "\t(T): Display all process queues and their info\n"
+        "\t(G): Process group operation (kill/suspend/resume/priority)\n"
+        "\t(W): Wait for a child process to exit\n"
+        "\t(M): Read or write a page of the current process' memory\n"
+        "\t(D): Issue an I/O request to a device\n"
+        "\t(A): Schedule a process arrival\n"
+        "\t(L): Import a Linux scheduler trace\n"
+        "\t(X): Run the simulation for a number of ticks\n"
+        "\t(B): Set the CPU/IO burst workload of a process\n"
+        "\t(U): Boost every ready process to high priority\n"
+        "\t(O): Configure simulator options\n");
+
+    while(Sched_running() && inputOpen) {    // While system is still running
+        printf("\nEnter command: ");
+        if(!read_char(&command))
+            break;
+        switch(command) {
+            case 'c':   // Create process
+            case 'C':
+                printf("Initializing Create process...\n");
+                printf("Set priority(low = 0, medium = 1, high = 2, real-time = 3, deadline = 4): ");
+                if(!read_int(&priority))
+                    break;
+                printf("\n");
+                if (priority == 3){
+                    printf("Enter real-time policy(FIFO = 1, RR = 2) and priority[%d to %d]: ", RT_MIN_PRIORITY, RT_MAX_PRIORITY);
+                    if(!read_int(&policy) || !read_int(&rtPriority))
+                        break;
+                    printf("\n");
+                    Create_rt(policy, rtPriority);
+                } else if (priority == 4){
+                    printf("Enter runtime, deadline and period (ticks): ");
+                    if(!read_long(&runtime) || !read_long(&relDeadline) || !read_long(&period))
+                        break;
+                    printf("\n");
+                    Create_deadline(runtime, relDeadline, period);
+                } else if (priority == 0 || priority == 1 || priority == 2){
+                    Create(priority);
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+            
+            case 'f':   // Fork process
+            case 'F':
+                Fork();
+                break;
+
+            case 'k':   // Kill process
+            case 'K': 
+                printf("Initializing Kill process...\n");
+                printf("Enter process PID: ");
+                if(!read_int(&pid))
+                    break;
+                printf("\n");
+                Kill(pid);
+                break;
+
+            case 'e':   // Exit current process
+            case 'E':
+                Exit();
+                break;
+
+            case 'q':   // End current time quantum
+            case 'Q':
+                Quantum();
+                break;
+
+            case 's':   // Send message to designated process
+            case 'S':
+                printf("Enter PID of target process: ");
+                if(!read_int(&pid))
+                    break;
+                printf("\nEnter message: ");
+                if(!read_input(msg, MAX_MSG, true))
+                    break;
+                printf("\n");
+                Send(pid, msg);
+                break;
+
+            case 'r':   // Receive message
+            case 'R':
+                Receive();
+                break;
+
+            case 'y':   // Reply to sender
+            case 'Y':
+                printf("Enter PID of target process: ");
+                if(!read_int(&pid))
+                    break;
+                printf("\nEnter message: ");
+                if(!read_input(msg, MAX_MSG, true))
+                    break;
+                printf("\n");
+                Reply(pid, msg);
+                break;
+
+            case 'n':   // Initialize semaphore
+            case 'N':
+                printf("Initializing semaphore...\n");
+                while(semID < 0 || semID > 4) {
+                    printf("Enter semaphore ID[0 to 4]: ");
+                    if(!read_int(&semID))
+                        break;
+                }
+                if(!inputOpen)
+                    break;
+                while(semVal < 0) {
+                    printf("Enter semaphore value[non-negative]: ");
+                    if(!read_int(&semVal))
+                        break;
+                }
+                if(!inputOpen)
+                    break;
+                printf("\n");
+                New_sem(semID, semVal);
+                break;
+
+            case 'p':   // Execute semaphore P() operation
+            case 'P':
+                printf("Initializing semaphore P() operation...\n");
+                while(semID < 0 || semID > 4) {
+                    printf("Enter semaphore ID[0 to 4]: ");
+                    if(!read_int(&semID))
+                        break;
+                }
+                if(!inputOpen)
+                    break;
+                length = 0;
+                if(Sem_order(semID) == WAITQ_DEADLINE) {
+                    printf("Enter deadline in ticks(0 = none): ");
+                    if(!read_long(&length))
+                        break;
+                }
+                printf("\n");
+                Sem_P(semID, length);
+                break;
+
+            case 'v':   // Execute semaphore V() operation
+            case 'V':
+                printf("Initializing semaphore V() operation...\n");
+                while(semID < 0 || semID > 4) {
+                    printf("Enter semaphore ID[0 to 4]: ");
+                    if(!read_int(&semID))
+                        break;
+                }
+                if(!inputOpen)
+                    break;
+                printf("\n");
+                Sem_V(semID);
+                break;
+
+            case 'j':   // Message channels
+            case 'J':
+                printf("Channel operation (o = open, s = send, r = receive): ");
+                if(!read_char(&option))
+                    break;
+                printf("Enter channel name: ");
+                if(!read_input(name, CHAN_MAX_NAME, false))
+                    break;
+                if(option == 'o' || option == 'O') {
+                    printf("Enter channel capacity(messages): ");
+                    if(!read_int(&count))
+                        break;
+                    printf("\n");
+                    Chan_create(name, count);
+                } else if(option == 's' || option == 'S') {
+                    printf("Enter message: ");
+                    if(!read_input(msg, MAX_MSG, true))
+                        break;
+                    printf("\n");
+                    Chan_send(name, msg);
+                } else if(option == 'r' || option == 'R') {
+                    printf("\n");
+                    Chan_receive(name);
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+
+            case 'z':   // Publish/subscribe topics
+            case 'Z':
+                printf("Topic operation (o = open, s = subscribe, u = unsubscribe, p = publish, r = receive): ");
+                if(!read_char(&option))
+                    break;
+                printf("Enter topic name: ");
+                if(!read_input(name, TOPIC_MAX_NAME, false))
+                    break;
+                if(option == 'o' || option == 'O') {
+                    printf("\n");
+                    Topic_create(name);
+                } else if(option == 's' || option == 'S' || option == 'u' || option == 'U') {
+                    printf("\n");
+                    Topic_join(name, option == 's' || option == 'S');
+                } else if(option == 'p' || option == 'P') {
+                    printf("Enter message: ");
+                    if(!read_input(msg, MAX_MSG, true))
+                        break;
+                    printf("\n");
+                    Topic_send(name, msg);
+                } else if(option == 'r' || option == 'R') {
+                    printf("\n");
+                    Topic_recv(name);
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+
+            case 'h':   // Execute semaphore V(n) / broadcast
+            case 'H':
+                printf("Initializing semaphore V(n) operation...\n");
+                printf("Enter semaphore ID[0 to 4]: ");
+                if(!read_int(&semID))
+                    break;
+                printf("Enter number of V() operations(0 = broadcast): ");
+                if(!read_int(&count))
+                    break;
+                printf("\n");
+                Sem_V_n(semID, count);
+                break;
+
+            case 'i':   // Display complete state info of process
+            case 'I':
+                printf("Initializing Display process info...\n");
+                printf("Enter process PID: ");
+                if(!read_int(&pid))
+                    break;
+                printf("\n");
+                Procinfo(pid);
+                break;
+
+            case 't':   // Display all process queues and their info
+            case 'T':
+                Totalinfo();
+                break;
+
+            case 'w':   // Wait for a child process
+            case 'W':
+                Wait();
+                break;
+
+            case 'm':   // Access memory
+            case 'M':
+                printf("Enter virtual page number[0 to %d]: ", MEM_MAX_VPN);
+                if(!read_int(&vpn))
+                    break;
+                printf("Read or write the page(read = 0, write = 1): ");
+                if(!read_int(&access))
+                    break;
+                printf("\n");
+                Access(vpn, access == 1);
+                break;
+
+            case 'd':   // Issue I/O request
+            case 'D':
+                printf("Enter device ID[0 to %d]: ", DEV_MAX_DEVICES - 1);
+                if(!read_int(&deviceID))
+                    break;
+                printf("Enter sector/block number: ");
+                if(!read_int(&sector))
+                    break;
+                printf("\n");
+                Device_io(deviceID, sector);
+                break;
+
+            case 'a':   // Schedule process arrival
+            case 'A':
+                printf("Set priority(low = 0, medium = 1, high = 2): ");
+                if(!read_int(&priority))
+                    break;
+                printf("Enter arrival delay in ticks: ");
+                if(!read_long(&length))
+                    break;
+                printf("\n");
+                Arrival(priority, length);
+                break;
+
+            case 'l':   // Import scheduler trace
+            case 'L':
+                printf("Enter trace file path: ");
+                if(!read_input(msg, MAX_MSG, true))
+                    break;
+                printf("Enter trace microseconds per tick: ");
+                if(!read_long(&length))
+                    break;
+                printf("\n");
+                Import_trace(msg, length);
+                break;
+
+            case 'x':   // Run simulation
+            case 'X':
+                printf("Enter number of ticks to run: ");
+                if(!read_long(&length))
+                    break;
+                printf("\n");
+                Run(length);
+                break;
+
+            case 'u':   // Priority boost
+            case 'U':
+                Boost();
+                break;
+
+            case 'b':   // Set burst workload
+            case 'B':
+                printf("Enter process PID: ");
+                if(!read_int(&pid))
+                    break;
+                printf("Burst model (s = script, r = random): ");
+                if(!read_char(&option))
+                    break;
+                if(option == 's' || option == 'S') {
+                    printf("Enter burst lengths (cpu io cpu ... cpu): ");
+                    if(!read_input(msg, MAX_MSG, true))
+                        break;
+                    printf("Enter I/O device ID(-1 = timed wait): ");
+                    if(!read_int(&deviceID))
+                        break;
+                    printf("\n");
+                    Set_burst_script(pid, msg, deviceID);
+                } else if(option == 'r' || option == 'R') {
+                    printf("Enter mean CPU burst, mean I/O burst (ticks) and number of CPU bursts: ");
+                    if(!read_long(&meanCpu) || !read_long(&meanIo) || !read_int(&count))
+                        break;
+                    printf("Enter I/O device ID(-1 = timed wait): ");
+                    if(!read_int(&deviceID))
+                        break;
+                    printf("\n");
+                    Set_burst_random(pid, meanCpu, meanIo, count, deviceID);
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+
+            case 'o':   // Configure simulator options
+            case 'O':
+                printf("Option to configure (m = memory, d = device, q = quantum length, b = arrival bursts, r = random seed, u = boost period, w = semaphore wait order, f = starvation threshold, c = context switch cost, p = preemptive mode, g = cgroup, e = energy, s = queue snapshot): ");
+                if(!read_char(&option))
+                    break;
+                if(option == 'm' || option == 'M') {
+                    printf("Enter number of physical frames: ");
+                    if(!read_int(&frames))
+                        break;
+                    printf("Enter replacement policy(LRU = 0, CLOCK = 1, ARC = 2): ");
+                    if(!read_int(&policy))
+                        break;
+                    printf("Enter page fault latency in ticks: ");
+                    if(!read_int(&latency))
+                        break;
+                    printf("Enter working set window in ticks: ");
+                    if(!read_long(&length))
+                        break;
+                    printf("\n");
+                    Configure_memory(frames, policy, latency, length);
+                } else if(option == 'u' || option == 'U') {
+                    printf("Enter ticks between priority boosts(0 = never): ");
+                    if(!read_long(&length))
+                        break;
+                    printf("\n");
+                    Configure_boost(length);
+                } else if(option == 'f' || option == 'F') {
+                    printf("Enter ready ticks before a starvation alarm(0 = never): ");
+                    if(!read_long(&length))
+                        break;
+                    printf("\n");
+                    Configure_starvation(length);
+                } else if(option == 'c' || option == 'C') {
+                    printf("Enter switch overhead, cache refill penalty, cache decay time and TLB flush cost (ticks): ");
+                    if(!read_long(&length) || !read_long(&cacheCost) || !read_long(&cacheDecay) || !read_long(&tlbCost))
+                        break;
+                    printf("\n");
+                    Configure_switch_cost(length, cacheCost, cacheDecay, tlbCost);
+                } else if(option == 'p' || option == 'P') {
+                    printf("Enter preemptive mode(off = 0, on = 1) and wakeup granularity in ticks: ");
+                    if(!read_int(&count) || !read_long(&length))
+                        break;
+                    printf("\n");
+                    Configure_preemption(count != 0, length);
+                } else if(option == 'g' || option == 'G') {
+                    printf("Cgroup operation (c = create, l = limit, a = attach process): ");
+                    if(!read_char(&option))
+                        break;
+                    printf("Enter cgroup name: ");
+                    if(!read_input(name, CG_MAX_NAME, false))
+                        break;
+                    if(option == 'c' || option == 'C') {
+                        printf("Enter parent cgroup name(/ = root) and weight[1 to %d]: ", CG_MAX_WEIGHT);
+                        if(!read_input(parent, CG_MAX_NAME, false) || !read_int(&count))
+                            break;
+                        printf("\n");
+                        Cgroup_create(name, parent, count);
+                    } else if(option == 'l' || option == 'L') {
+                        printf("Enter quota and period in ticks(quota 0 = no limit): ");
+                        if(!read_long(&runtime) || !read_long(&period))
+                            break;
+                        printf("\n");
+                        Cgroup_limit(name, runtime, period);
+                    } else if(option == 'a' || option == 'A') {
+                        printf("Enter process PID: ");
+                        if(!read_int(&pid))
+                            break;
+                        printf("\n");
+                        Cgroup_attach(pid, name);
+                    } else
+                        printf("Error: Invalid input. Please try again...\n");
+                } else if(option == 'e' || option == 'E') {
+                    printf("Energy option (p = P-states, c = C-states, g = governor): ");
+                    if(!read_char(&option))
+                        break;
+                    if(option == 'g' || option == 'G') {
+                        printf("Enter frequency governor(performance = 0, powersave = 1, ondemand = 2): ");
+                        if(!read_int(&count))
+                            break;
+                        printf("\n");
+                        Configure_governor(count);
+                        break;
+                    }
+                    if(option != 'p' && option != 'P' && option != 'c' && option != 'C') {
+                        printf("Error: Invalid input. Please try again...\n");
+                        break;
+                    }
+                    printf("Enter number of states[1 to %d]: ", ENERGY_MAX_STATES);
+                    if(!read_int(&count))
+                        break;
+                    if(count < 1 || count > ENERGY_MAX_STATES) {
+                        printf("Error: Invalid input. Please try again...\n");
+                        break;
+                    }
+                    bool valid = true;
+                    for(int i = 0; i < count && valid; i++) {
+                        if(option == 'p' || option == 'P') {
+                            printf("Enter speed(percent) and power of P%d: ", i);
+                            valid = read_int(&stateSpeed[i]) && read_int(&statePower[i]);
+                        } else {
+                            printf("Enter power, exit latency and target residency(ticks) of C%d: ", i + 1);
+                            valid = read_int(&statePower[i]) && read_int(&stateLatency[i]) && read_int(&stateResidency[i]);
+                        }
+                    }
+                    if(!valid)
+                        break;
+                    printf("\n");
+                    if(option == 'p' || option == 'P')
+                        Configure_pstates(count, stateSpeed, statePower);
+                    else
+                        Configure_cstates(count, statePower, stateLatency, stateResidency);
+                } else if(option == 's' || option == 'S') {
+                    printf("Snapshot (w = write to file, d = show changes since the last snapshot): ");
+                    if(!read_char(&option))
+                        break;
+                    if(option == 'w' || option == 'W') {
+                        printf("Enter file name: ");
+                        if(!read_input(msg, MAX_MSG, false))
+                            break;
+                        printf("\n");
+                        Snapshot(msg);
+                    } else if(option == 'd' || option == 'D') {
+                        printf("\n");
+                        Snapshot_diff();
+                    } else
+                        printf("Error: Invalid input. Please try again...\n");
+                } else if(option == 'w' || option == 'W') {
+                    printf("Enter semaphore ID[0 to 4]: ");
+                    if(!read_int(&semID))
+                        break;
+                    printf("Enter wait order(FIFO = 0, priority = 1, deadline = 2): ");
+                    if(!read_int(&discipline))
+                        break;
+                    printf("\n");
+                    Configure_sem_order(semID, discipline);
+                } else if(option == 'd' || option == 'D') {
+                    printf("Enter device ID[0 to %d]: ", DEV_MAX_DEVICES - 1);
+                    if(!read_int(&deviceID))
+                        break;
+                    printf("Enter device type(block = 0, network = 1): ");
+                    if(!read_int(&devType))
+                        break;
+                    printf("Enter queue discipline(FIFO = 0, elevator = 1, deadline = 2): ");
+                    if(!read_int(&discipline))
+                        break;
+                    printf("Enter service time distribution(fixed = 0, uniform = 1, exponential = 2): ");
+                    if(!read_int(&distribution))
+                        break;
+                    printf("Enter mean service time in ticks: ");
+                    if(!read_int(&meanService))
+                        break;
+                    printf("Enter request deadline in ticks: ");
+                    if(!read_int(&deadline))
+                        break;
+                    printf("\n");
+                    Configure_device(deviceID, devType, discipline, distribution, meanService, deadline);
+                } else if(option == 'q' || option == 'Q') {
+                    printf("Set priority level(low = 0, medium = 1, high = 2, all = 3): ");
+                    if(!read_int(&priority))
+                        break;
+                    printf("Enter quantum length in ticks: ");
+                    if(!read_long(&length))
+                        break;
+                    printf("\n");
+                    Configure_quantum(priority, length);
+                } else if(option == 'r' || option == 'R') {
+                    printf("Enter random seed(0 = default): ");
+                    if(!read_long(&length))
+                        break;
+                    printf("\n");
+                    Random_seed((unsigned long)length);
+                    printf("Success: Random seed set to %lu\n", Random_get_seed());
+                } else if(option == 'b' || option == 'B') {
+                    printf("Enter mean CPU burst, mean I/O burst (ticks) and number of CPU bursts(0 = none): ");
+                    if(!read_long(&meanCpu) || !read_long(&meanIo) || !read_int(&count))
+                        break;
+                    printf("Enter I/O device ID(-1 = timed wait): ");
+                    if(!read_int(&deviceID))
+                        break;
+                    printf("\n");
+                    if(count == 0)
+                        Configure_arrivals(NULL);
+                    else {
+                        Burst* model = Burst_random(meanCpu, meanIo, count, deviceID);
+                        if(model)
+                            Configure_arrivals(model);
+                        else
+                            printf("Error: Invalid burst model. Returning to Main Menu...\n");
+                    }
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+
+            case 'g':   // Process group operation
+            case 'G':
+                printf("Initializing process group operation...\n");
+                printf("Enter group ID: ");
+                if(!read_int(&groupID))
+                    break;
+                printf("Group operation (k = kill, s = suspend, r = resume, p = change priority): ");
+                if(!read_char(&groupOp))
+                    break;
+                printf("\n");
+                if(groupOp == 'k' || groupOp == 'K')
+                    Kill_group(groupID);
+                else if(groupOp == 's' || groupOp == 'S')
+                    Suspend_group(groupID);
+                else if(groupOp == 'r' || groupOp == 'R')
+                    Resume_group(groupID);
+                else if(groupOp == 'p' || groupOp == 'P') {
+                    printf("Set priority(low = 0, medium = 1, high = 2): ");
+                    if(!read_int(&priority))
+                        break;
+                    printf("\n");
+                    if (priority == 0 || priority == 1 || priority == 2)
+                        Priority_group(groupID, priority);
+                    else
+                        printf("Error: Invalid input. Please try again...\n");
+                } else
+                    printf("Error: Invalid input. Please try again...\n");
+                break;
+
+            default:
+                printf("Error: Invalid input. Please try again...\n");
+        }
+    }
+}
+
+
+// Reads the next token (or the rest of the line) of user input
+bool read_input(char* buf, int size, bool line) {
+    if(Replay_mode() == REPLAY_REPLAY) {
+        int result = Replay_next_input(buf, size);
+        if(result == REPLAY_DIVERGED)
+            replay_diverged(true, -1, -1);
+        if(result == REPLAY_SUCCESS)
+            return true;
+    } else {
+        int c;
+        int n = 0;
+        do {    // Skip leading whitespace, including the end of the previous line
+            c = getchar();
+        } while(c != EOF && isspace(c));
+        while(c != EOF && c != '\n' && (line || !isspace(c))) {
+            if(n + 1 < size)
+                buf[n++] = (char)c;
+            c = getchar();
+        }
+        while(n > 0 && isspace((unsigned char)buf[n - 1]))  // Trailing '\r' of CRLF input
+            n--;
+        buf[n] = '\0';
+        if(n > 0) {
+            Replay_log_input(buf);
+            return true;
+        }
+    }
+    printf("\nEnd of input. Shutting down...\n");
+    inputOpen = false;
+    return false;
+}
+
+// Reads a number or a single character token
+bool read_int(int* value) {
+    char token[32];
+    char* end;
+    if(!read_input(token, sizeof(token), false))
+        return false;
+    long number = strtol(token, &end, 10);
+    *value = (*end == '\0' && number >= INT_MIN && number <= INT_MAX) ? (int)number : INT_MIN;
+    return true;
+}
+
+bool read_long(long* value) {
+    char token[32];
+    char* end;
+    if(!read_input(token, sizeof(token), false))
+        return false;
+    long number = strtol(token, &end, 10);
+    *value = *end == '\0' ? number : LONG_MIN;
+    return true;
+}
+
+bool read_char(char* value) {
+    char token[32];
+    if(!read_input(token, sizeof(token), false))
+        return false;
+    *value = token[0];
+    return true;
+}
+
+// Handles --record <log> and --replay <log>
+bool start_replay(int argc, char* argv[]) {
+    if(argc == 1)
+        return true;
+    if(argc == 3 && strcmp(argv[1], "--record") == 0) {
+        if(Replay_record(argv[2], Random_get_seed()) != REPLAY_SUCCESS) {
+            printf("Error: Cannot create record log %s\n", argv[2]);
+            return false;
+        }
+        printf("Success: Recording to %s\n", argv[2]);
+        return true;
+    }
+    if(argc == 3 && strcmp(argv[1], "--replay") == 0) {
+        unsigned long seed;
+        if(Replay_replay(argv[2], &seed) != REPLAY_SUCCESS) {
+            printf("Error: %s is not a record log\n", argv[2]);
+            return false;
+        }
+        Random_seed(seed);
+        printf("Success: Replaying %s\n", argv[2]);
+        return true;
+    }
+    printf("Usage: %s [--record <log> | --replay <log> | --serve <socket>]\n", argv[0]);
+    return false;
+}
@@ -0,0 +1,23 @@
+// Command line front end header file
+#ifndef _CLI_H_
+#define _CLI_H_
+#include <stdbool.h>
+
+// Read user inputs and execute the commands
+void read_cmd();
+
+// Reads the next whitespace separated token of user input into buf (the rest of the line if
+// line is true). Inputs are logged when recording and come from the log when replaying
+// Returns false once the input runs out, which ends the command loop
+bool read_input(char* buf, int size, bool line);
+
+// Reads a number or a single character token, invalid numbers read as INT_MIN/LONG_MIN
+// Return false once the input runs out
+bool read_int(int* value);
+bool read_long(long* value);
+bool read_char(char* value);
+
+// Handles --record <log> and --replay <log>, returns false on bad arguments or an unusable log
+bool start_replay(int argc, char* argv[]);
+
+#endif
@@ -1,760 +1,3091 @@
-#include "commands.h"
-#include "PCB.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdbool.h>
-#include <assert.h>
-
-int main(){
-    printf("Booting system...\n");
-    start_simulator();  // Initialize simulator
-    read_cmd();         // Read user inputs and execute the commands
-
-    // Free all queues and semaphores
-    FREE_FN free_fn = &free_item;
-    List_free(highQueue, free_fn);
-    List_free(medQueue, free_fn);
-    List_free(lowQueue, free_fn);
-    List_free(recvQueue, free_fn);
-    List_free(sendQueue, free_fn);
-    for(int i = 0; i < 5; i++) {
-        List_free(sem[i].semQueue, free_fn);
-    }
-
-    printf("Shutting down...\n");
-    return 0;
-}
-
-void start_simulator(){
-    printf("Starting simulator...\n");
-    // 3 ready queues of different priorities
-    highQueue = List_create();
-    medQueue = List_create();
-    lowQueue = List_create();
-    
-    // 2 wait queues for blocked processes
-    // List of blocked processes waiting for a message to be sent
-    recvQueue = List_create();
-    // List of blocked processes that sent a message and are waiting for a reply
-    sendQueue = List_create();
-
-    if(!(highQueue && medQueue && lowQueue && recvQueue && sendQueue)) {
-        printf("Queue creation error.\n");
-        return;
-    } else
-        printf("Success: 3 ready queues, 2 wait queues created\n");
-
-    // Create 5 semaphores with initial value -1
-    for(int i = 0; i < 5; i++) {
-        sem[i].value = -1;
-        sem[i].active = false;
-        sem[i].semQueue = List_create();
-        if(sem[i].semQueue == NULL) {
-            printf("Error: Failed to create semaphore\n");
-            return;
-        } else
-            printf("Success: Created semaphore %d\n", i);
-    }
-
-    // Init process only runs when no other processes are ready to execute, but it never blocks
-    // Init process cannot be killed or exited unless it is the last process in the system
-    // after which the simulation terminates
-    init = PCB_create(-1);  // -1 = no priority, init passes control to process next on the ready queue
-    if(!init) {
-        printf("Error: Failied to create init process\n");
-        return;
-    }
-    init->PID = 0;
-    init->pState = RUNNING;
-    curr = init;
-    printf("Running: Process init\n");
-}
-
-void read_cmd() {
-    // Variables for parameters
-    char command;
-    int priority;
-    int pid;
-    int semID = -1;
-    int semVal = -1;
-    char msg[MAX_MSG];
-
-    printf("\nCommand List:\n"
-        "\t(C): Create process\n"
-        "\t(F): Fork process\n"
-        "\t(K): Kill process\n"
-        "\t(E): Exit current process\n"
-        "\t(Q): End current time quantum\n"
-        "\t(S): Send message to designated process\n"
-        "\t(R): Receive message\n"
-        "\t(Y): Reply to sender\n"
-        "\t(N): Initialize semaphore\n"
-        "\t(P): Execute semaphore P() operation\n"
-        "\t(V): Execute semaphore V() operation\n"
-        "\t(I): Display complete state info of process\n"
-        "\t(T): Display all process queues and their info\n");
-
-    while(sysRunning) {    // While system is still running
-        printf("\nEnter command: ");
-        scanf(" %c", &command);
-        switch(command) {
-            case 'c':   // Create process
-            case 'C':
-                printf("Initializing Create process...\n");
-                printf("Set priority(low = 0, medium = 1, high = 2): ");
-                scanf("%d", &priority);
-                printf("\n");
-                if (priority == 0 || priority == 1 || priority == 2){
-                    Create(priority);
-                } else
-                    printf("Error: Invalid input. Please try again...\n");
-                break;
-            
-            case 'f':   // Fork process
-            case 'F':
-                Fork();
-                break;
-
-            case 'k':   // Kill process
-            case 'K': 
-                printf("Initializing Kill process...\n");
-                printf("Enter process PID: ");
-                scanf("%d", &pid);
-                printf("\n");
-                Kill(pid);
-                break;
-
-            case 'e':   // Exit current process
-            case 'E':
-                Exit();
-                break;
-
-            case 'q':   // End current time quantum
-            case 'Q':
-                Quantum();
-                break;
-
-            case 's':   // Send message to designated process
-            case 'S':
-                printf("Enter PID of target process: ");
-                scanf("%d", &pid);
-                printf("\nEnter message: ");
-                scanf(" %[^\n]s", msg); // read until newline
-                printf("\n");
-                // Clear stdin buffer
-                fflush(stdin);
-                // int c;
-                // while ((c = getchar()) != '\n' && c != EOF) { }
-                Send(pid, msg);
-                break;
-
-            case 'r':   // Receive message
-            case 'R':
-                Receive();
-                break;
-
-            case 'y':   // Reply to sender
-            case 'Y':
-                printf("Enter PID of target process: ");
-                scanf("%d", &pid);
-                printf("\nEnter message: ");
-                scanf(" %[^\n]s", msg); // read until newline
-                printf("\n");
-                // Clear stdin buffer
-                fflush(stdin);
-                // int c;
-                // while ((c = getchar()) != '\n' && c != EOF) { }
-                Reply(pid, msg);
-                break;
-
-            case 'n':   // Initialize semaphore
-            case 'N':
-                printf("Initializing semaphore...\n");
-                while(semID < 0 || semID > 4) {
-                    printf("Enter semaphore ID[0 to 4]: ");
-                    scanf("%d", &semID);
-                }
-                while(semVal < 0) {
-                    printf("Enter semaphore value[non-negative]: ");
-                    scanf("%d", &semVal);
-                }
-                printf("\n");
-                New_sem(semID, semVal);
-                break;
-
-            case 'p':   // Execute semaphore P() operation
-            case 'P':
-                printf("Initializing semaphore P() operation...\n");
-                while(semID < 0 || semID > 4) {
-                    printf("Enter semaphore ID[0 to 4]: ");
-                    scanf("%d", &semID);
-                }
-                printf("\n");
-                Sem_P(semID);
-                break;
-
-            case 'v':   // Execute semaphore V() operation
-            case 'V':
-                printf("Initializing semaphore V() operation...\n");
-                while(semID < 0 || semID > 4) {
-                    printf("Enter semaphore ID[0 to 4]: ");
-                    scanf("%d", &semID);
-                }
-                printf("\n");
-                Sem_V(semID);
-                break;
-
-            case 'i':   // Display complete state info of process
-            case 'I':
-                printf("Initializing Display process info...\n");
-                printf("Enter process PID: ");
-                scanf("%d", &pid);
-                printf("\n");
-                Procinfo(pid);
-                break;
-
-            case 't':   // Display all process queues and their info
-            case 'T':
-                Totalinfo();
-                break;
-
-            default:
-                printf("Error: Invalid input. Please try again...\n");
-        }
-
-        // If no process is running, run init
-        if(curr == NULL) {
-            init->pState = RUNNING;
-            curr = init;
-            printf("Running: Process init\n");
-        }
-    }
-}
-
-void Create(int priority) {
-    PCB* process = PCB_create(priority);
-    if(process == NULL) {
-        printf("Error: Process creation failed. Returning to Main Menu...\n");
-        return;
-    }
-    printf("Success: Process %d created\n", process->PID);
-    // If init is running, make new process the current running process
-    if(curr->PID == 0) {
-        init->pState = READY;
-        process->pState = RUNNING;
-        curr = process;
-        printf("Process %d is running\n", process->PID);
-        return;
-    }
-    // Place current process in the appropriate ready queue
-    if(process->priority == HIGH)
-        List_append(highQueue, process);
-    else if(process->priority == MED)
-        List_append(medQueue, process);
-    else
-        List_append(lowQueue, process);
-}
-
-void Fork() {
-    if(curr->PID == 0) {  // Cannot fork init process
-        printf("Error: Cannot fork init process. Returning to Main Menu...\n");
-        return;
-    }
-    // Fork process
-    PCB* fp = PCB_create(curr->priority);   // Create new process with same priority as current process
-    fp->senderPID = curr->senderPID;    // Copy senderPID
-    // Copy message buffers
-    strncpy(fp->recv_msg, curr->recv_msg, MAX_MSG);
-    strncpy(fp->send_msg, curr->send_msg, MAX_PROCESS_MSG);
-    // Add forked process to the appropriate ready queue
-    if(fp->priority == HIGH)
-        List_append(highQueue, fp);
-    else if(fp->priority == MED)
-        List_append(medQueue, fp);
-    else
-        List_append(lowQueue, fp);
-
-    printf("Fork: process %d created\n", fp->PID);
-}
-
-void Kill(int pid) {
-    if(curr->PID == pid) {   // Kill current process in Exit()
-        Exit();
-        return;
-    } else if(pid == 0) {   // Cannot kill init process
-        printf("Error: Cannot terminate init process. Returning to Main Menu...\n");
-        return;
-    } else {    // Search and kill process
-        List* searchQueue = search_process(pid);
-        if(searchQueue) {
-            for(int i = 0; i < 5; i++) {    // Case: Kill process blocked on semaphore and increment semaphore value
-                if(searchQueue == sem[i].semQueue) {
-                    printf("The process was blocked on Semaphore %d\n", i);
-                    printf("Incrementing Semaphore value by 1\n");
-                    sem[i].value += 1;
-                    printf("Semaphore %d now has value %d\n", i, sem[i].value);
-                }
-            }
-
-            PCB_free(List_remove(searchQueue)); // Free process
-            printf("Success: Terminated Process %d\n", pid);
-        } else
-            printf("Error: Process %d not found\n", pid);
-    }
-}
-
-void Exit() {
-    // Cannot exit init process if there are other processes in the system
-    if(curr->PID == 0) {
-        if(List_count(highQueue) > 0 || List_count(medQueue) > 0 || List_count(lowQueue) > 0 || 
-            List_count(sem[0].semQueue) > 0 || List_count(sem[1].semQueue) > 0 || List_count(sem[2].semQueue) > 0 ||
-            List_count(sem[3].semQueue) > 0 || List_count(sem[4].semQueue) > 0 || List_count(recvQueue) > 0 ||
-            List_count(sendQueue) > 0) {
-            printf("Error: Cannot exit init process. Returning to Main Menu...\n");
-        } else {
-            PCB_free(init);
-            printf("Success: Init process terminated. Shutting down...\n");
-            sysRunning = false;
-        }
-        return;
-    }
-    // Free current process
-    PCB_free(curr);
-    curr = NULL;
-    printf("Success: Terminated current process\n");
-    switch_process();
-}
-
-void Quantum() {
-    printf("Time quantum reached...\n");
-    if(curr != init) {
-        // Lower priority of current process
-        // if(curr->priority == HIGH) {
-        //     curr->priority = MED;
-        //     List_append(medQueue, curr);
-        //     printf("Priority changed to medium(MED)\n");
-        // } else if(curr->priority == MED) {
-        //     curr->priority = LOW;
-        //     List_append(lowQueue, curr);
-        //     printf("Priority changed to low(LOW)\n");
-        // } else
-        //     List_append(lowQueue, curr);
-        curr->pState = READY;
-        // pick next current from ready processes; switch to init if none
-        switch_process();
-    } else
-        printf("Runnig: init\n");
-}
-
-void Send(int pid, char* msg) {
-    PCB* target = NULL;
-    List* searchQueue = NULL;
-    // Search for process
-    if(pid == curr->PID) {
-        printf("Error: Cannot send message to self. Returning to Main Menu...\n");
-        return;
-    } else if(pid == 0) {
-        target = init;
-    } else {
-        searchQueue = search_process(pid);
-        if(searchQueue) {
-            target = List_curr(searchQueue);
-            if(target->pState == BLOCKED) {
-                printf("Error: Process %d is blocked. Returning to Main Menu...\n", pid);
-                return;
-            }
-        } else {
-            printf("Error: Process %d not found. Returning to Main Menu...\n", pid);
-            return;
-        }
-    }
-    // If current is not init, block current process
-    if(curr != init) {
-        curr->pState = BLOCKED;
-        List_append(sendQueue, curr);
-        printf("Success: Process %d sent a message and is now blocked. \nWaiting for reply...\n", curr->PID);
-    } else 
-        printf("Success: Process %d sent a message. Cannot block init process\n", curr->PID);
-    
-    // If recipient is in blocked queue, unblock and copy message to display
-    if(searchQueue == recvQueue) {
-        target->pState = READY; // Unblock process
-        strncpy(target->recv_msg, msg, MAX_MSG);
-        target->senderPID = curr->PID;
-        // sprintf(target->send_msg, "Process %d sent a message: %s\n", curr->PID, target->recv_msg);
-        // target->recv_msg[0] = '\0'; // Clear message to prevent duplicates
-
-        List_remove(recvQueue);
-        printf("Success: Process %d received a message, process ublocked\n", target->PID);
-        if(target->priority == HIGH)
-            List_append(highQueue, target);
-        else if(target->priority == MED)
-            List_append(medQueue, target);
-        else
-            List_append(lowQueue, target);
-    } else {    // If recipient is not in blocked queue, copy message and sender
-        strncpy(target->recv_msg, msg, MAX_PROCESS_MSG);
-        target->senderPID = curr->PID;
-        printf("Success: Process %d received a message\n", target->PID);
-        if(curr != init)
-            switch_process();
-    }
-}
-
-void Receive() {
-    if(curr->recv_msg[0] != '\0') {
-        printf("Process %d sent a message: %s\n", curr->senderPID, curr->recv_msg);
-        curr->recv_msg[0] = '\0'; // Clear message to prevent duplicates
-        curr->senderPID = -1;   // Clear senderPID
-    } else {    // If no message, block process unless it is init
-        if(curr != init) {
-            curr->pState = BLOCKED;
-            List_append(recvQueue, curr);
-            printf("No messages: Process %d is now blocked. Waiting for message...\n", curr->PID);
-            switch_process();
-        } else
-            printf("No messages: Cannot block init process. Returning to Main Menu...\n");
-    }
-}
-
-void Reply(int pid, char* msg) {
-    // Search for process using PID
-    if(pid == curr->PID) {
-        printf("Error: Cannot reply to self. Returning to Main Menu...\n");
-        return;
-    }
-
-    PCB* sender = NULL;
-    if(pid == 0) {
-        sender = init;
-    } else {
-        List* searchQueue = search_process(pid);
-        if(searchQueue) {
-            sender = List_curr(searchQueue);
-            if(sender->pState == BLOCKED) {
-                printf("Error: Process %d is blocked. Returning to Main Menu...\n", pid);
-                return;
-            }
-        } else if(searchQueue != sendQueue) {
-            printf("Error: Process %d has not sent a message. Returning to Main Menu...\n", pid);
-            return;
-        } else {
-            printf("Error: Process %d not found. Returning to Main Menu...\n", pid);
-            return;
-        }
-    }
-    // Unblock sender and copy message to display
-    sender->pState = READY; // Unblock process
-    strncpy(sender->recv_msg, msg, MAX_MSG);
-    // sprintf(sender->send_msg, "Process %d sent a message: %s\n", curr->PID, sender->recv_msg);
-    // sender->recv_msg[0] = '\0'; // Clear message to prevent duplicates
-    printf("Success: Process %d received a reply\n", sender->PID);
-    
-    // If current is not init, block current process
-    if(sender != init) {
-        if(curr == init) {  // If current is init, unblock sender
-            switch_process();
-        }
-        if(sender->priority == HIGH)
-            List_append(highQueue, sender);
-        else if(sender->priority == MED)
-            List_append(medQueue, sender);
-        else
-            List_append(lowQueue, sender);
-    }
-}
-
-void New_sem(int semID, int value) {
-    if(semID < 0 || semID > 4) {
-        printf("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
-        return;
-    }
-    if(sem[semID].active) {
-        printf("Error: Semaphore %d already exists. Returning to Main Menu...\n", semID);
-        return;
-    }
-    if(value < 0) {
-        printf("Error: Invalid semaphore value, value must be positive. Returning to Main Menu...\n");
-        return;
-    }
-    sem[semID].value = value;
-    sem[semID].active = true;
-    printf("Success: Semaphore %d created with value %d\n", semID, value);
-}
-
-void Sem_P(int semID) {
-    if(semID < 0 || semID > 4) {
-        printf("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
-        return;
-    }
-    if(!sem[semID].active) {
-        printf("Error: Semaphore %d does not exist. Returning to Main Menu...\n", semID);
-        return;
-    }
-    // Decrement semaphore value
-    sem[semID].value -= 1;
-    if(sem[semID].value > 0) {
-        printf("Success: Process %d did P() on Semaphore %d (value: %d). Process is not blocked\n", curr->PID, semID, sem[semID].value);
-    } else {    // Semaphore value is < 0, block process
-        if(curr->PID == 0) {
-            printf("Success: Process %d did P() on Semaphore %d (value: %d). Unable to block process init\n", curr->PID, semID, sem[semID].value);
-            // return;
-        } else {
-            printf("Success: Process %d did P() on Semaphore %d (value %d). Process blocked\n", curr->PID, semID, sem[semID].value);
-            curr->pState = BLOCKED;
-            List_append(sem[semID].semQueue, curr);
-        }
-    }
-    // If current process is blocked on semaphore, switch to next process
-    if(curr->pState == BLOCKED)
-        switch_process();
-}
-
-void Sem_V(int semID) {
-    if(semID < 0 || semID > 4) {
-        printf("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
-        return;
-    }
-    if(!sem[semID].active) {
-        printf("Error: Semaphore %d does not exist. Returning to Main Menu...\n", semID);
-        return;
-    }
-    // Increment semaphore value
-    sem[semID].value += 1;
-    // Unblock process if semaphore value is <= 0
-    if(sem[semID].value <= 0) {
-        List_first(sem[semID].semQueue);
-        PCB* process = List_remove(sem[semID].semQueue);
-        if(!process) {
-            printf("Error: Semaphore %d queue is empty. Returning to Main Menu...\n", semID);
-            return;   
-        }
-        printf("Success: Process %d did V() on Semaphore %d (value: %d). Process unblocked\n", process->PID, semID, sem[semID].value);
-        process->pState = READY;
-        
-        // Place process in ready queue, if init is running switch to new process
-        if(curr->PID == 0) {
-            switch_process();
-        } else {
-            if(process->priority == HIGH)
-                List_append(highQueue, process);
-            else if(process->priority == MED)
-                List_append(medQueue, process);
-            else
-                List_append(lowQueue, process);
-        }
-        process = NULL;
-    } else {
-        printf("Success: Process %d did V() on Semaphore %d (value: %d). Process is not blocked\n", curr->PID, semID, sem[semID].value);
-    }
-    
-}
-
-void Procinfo(int pid) {
-    if(pid == 0) {  // Display info for init process
-        printf("Process ID: %d\n", init->PID);
-        printf("Priority: %d\n", init->priority);
-        printf("State: %d\n", init->pState);
-        printf("Sender PID: %d\n", init->senderPID);
-        printf("Receive Message: %s\n", init->recv_msg);
-        printf("Send Message: %s\n", init->send_msg);
-        return;
-    }
-    PCB* process = NULL;
-    List* searchQueue = NULL;
-    if(curr->PID == pid) {  // If current process is the one being searched for
-        printf("Running: Process %d\n", curr->PID);
-        process = curr;
-    } else {    // If process is in a queue
-        searchQueue = search_process(pid);
-        if(searchQueue) {
-            process = List_curr(searchQueue);
-            printf("Process %d is not running\n", pid);
-        } else {
-            printf("Error: Process %d does not exist. Returning to Main Menu...\n", pid);
-            return;
-        }
-    }
-
-    printf("Process ID: %d\n", process->PID);
-    printf("Priority: %d\n", process->priority);
-    printf("Sender PID: %d\n", process->senderPID);
-    printf("Receive Message: %s\n", process->recv_msg);
-    printf("Send Message: %s\n", process->send_msg);
-    printf("State: %d\n", process->pState);
-    if(process->pState == BLOCKED) {
-        if(searchQueue == sendQueue)
-            printf("\tProcess is blocked on send, waiting for reply\n");
-        else if(searchQueue == recvQueue)
-            printf("\tProcess is blocked on receive, waiting for message\n");
-        else if (searchQueue == sem[0].semQueue)
-            printf("\tProcess is blocked on semaphore 1\n");
-        else if (searchQueue == sem[1].semQueue)
-            printf("\tProcess is blocked on semaphore 2\n");
-        else if (searchQueue == sem[2].semQueue)
-            printf("\tProcess is blocked on semaphore 3\n");
-        else if (searchQueue == sem[3].semQueue)
-            printf("\tProcess is blocked on semaphore 4\n");
-        else if (searchQueue == sem[4].semQueue)
-            printf("\tProcess is blocked on semaphore 5\n");
-        else 
-            printf("\t Error: Process is blocked but not on a queue");
-    }
-}
-
-void Totalinfo() {
-    printf("Displaying all process queues and their info...\n\n");
-    printf("High Priority Queue: ");
-    print_queue(highQueue);
-    printf("Medium Priority Queue: ");
-    print_queue(medQueue);
-    printf("Low Priority Queue: ");
-    print_queue(lowQueue);
-    printf("\nReceive Queue: ");
-    print_queue(recvQueue);
-    printf("Send Queue: ");
-    print_queue(sendQueue);
-    printf("\nSemaphore 0 Queue: ");
-    print_queue(sem[0].semQueue);
-    printf("Semaphore 1 Queue: ");
-    print_queue(sem[1].semQueue);
-    printf("Semaphore 2 Queue: ");
-    print_queue(sem[2].semQueue);
-    printf("Semaphore 3 Queue: ");
-    print_queue(sem[3].semQueue);
-    printf("Semaphore 4 Queue: ");
-    print_queue(sem[4].semQueue);
-}
-
-// -------------------------------------- Helper Functions --------------------------------------
-
-// Function to compare integers, used by search_process().
-bool compare_int(void* pItem, void* pComp){
-    if (((PCB*)pItem)->PID == *((int*)(pComp))){
-        return true;
-    }
-    return false;
-}
-
-// Search all queues for the process with the given pid
-List* search_process(int pid) {
-    List* returnQueue = NULL;
-    if (curr->PID == pid){
-        printf("Current process is the target of search\n");
-        return NULL;
-    }
-
-    COMPARATOR_FN compare = &compare_int;
-    List_first(highQueue);
-    if(List_search(highQueue, compare, &pid)) { // Search high priority queue
-        // printf("Target process is in the high priority queue\n");
-        returnQueue = highQueue;
-    }
-
-    List_first(medQueue);
-    if(List_search(medQueue, compare, &pid)) {  // Search medium priority queue
-        // printf("Target process is in the medium priority queue\n");
-        returnQueue = medQueue;
-    }
-
-    List_first(lowQueue);
-    if(List_search(lowQueue, compare, &pid)) {  // Search low priority queue
-        // printf("Target process is in the low priority queue\n");
-        returnQueue = lowQueue;
-    }
-
-    List_first(recvQueue);
-    if(List_search(recvQueue, compare, &pid)) { // Search receive queue
-        // printf("Target process is in the receive queue\n");
-        returnQueue = recvQueue;
-    }
-
-    List_first(sendQueue);
-    if(List_search(sendQueue, compare, &pid)) { // Search send queue
-        // printf("Target process is in the send queue\n");
-        returnQueue = sendQueue;
-    }
-
-    for(int i = 0; i < 5; i++) {    // Search all semaphore queues
-        List_first(sem[i].semQueue);
-        if(List_search(sem[i].semQueue, compare, &pid)) {
-            // printf("Target process is in the semaphore %d queue\n", i);
-            returnQueue = sem[i].semQueue;
-        }
-    }
-
-    return returnQueue;
-}
-
-// Function to switch to the next process in the ready queue or init if no processes in ready queue
-void switch_process() {
-    printf("Switching to next process...\n");
-    // Place current process in temp and set to ready
-    // if(curr != init) {
-    //     PCB* temp = curr;
-    //     temp->pState = READY;
-    //     // Add current process to appropriate queue
-    //     if(temp->priority == 0) {
-    //         List_append(highQueue, temp);
-    //     } else if(temp->priority == 1) {
-    //         List_append(medQueue, temp);
-    //     } else if(temp->priority == 2) {
-    //         List_append(lowQueue, temp);
-    //     }
-    // }
-
-    // Set current process to next process in ready queue based on priority
-    if(List_count(highQueue)) {
-        List_first(highQueue);
-        curr = List_remove(highQueue);
-        curr->pState = RUNNING;
-    } else if(List_count(medQueue)) {
-        List_first(medQueue);
-        curr = List_remove(medQueue);
-        curr->pState = RUNNING;
-    } else if(List_count(lowQueue)) {
-        List_first(lowQueue);
-        curr = List_remove(lowQueue);
-        curr->pState = RUNNING;
-    } else {
-        curr = init;
-        curr->pState = RUNNING;
-    }
-
-    // Print process message
-    if(curr->PID == 0)    // Case: Init process
-        printf("Running: Init process\n");
-    // else if (*curr->send_msg != '\0') { // Case: Process has a message to send, print message and clear message
-    //     printf("Running: Process %d contains a message to send\n", curr->PID);
-    //     printf("%s\n", curr->send_msg);
-    //     *curr->send_msg = '\0';
-    // } 
-    else  // Case: Process has no message to send
-        printf("Running: Process %d\n", curr->PID);
-}
-
-// Function to print the processes of a given queue, used by Totalinfo()
-void print_queue(List* queue) {
-    if(!queue) {    // Case: Queue does not exist
-        printf("Error: queue does not exist\n");
-        return;
-    }
-
-    if(List_count(queue) == 0) {    // Case: Queue is empty
-        printf("\n");
-        return;
-    }
-
-    PCB* proc = List_first(queue);
-    while (proc != NULL){   // Print all processes in queue
-        printf("%d | ", proc->PID);
-        proc = List_next(queue);
-    }
-    printf("\n");
-
-    free(proc);
-}
-
-// Free function for PCB, does nothing
-void free_item(void *pItem) {}
+#include "commands.h"
+#include "PCB.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdarg.h>
+#include "random.h"
+
+static List* highQueue;
+static List* medQueue;
+static List* lowQueue;
+static List* recvQueue;
+static List* sendQueue;
+static List* suspendQueue;
+static List* waitQueue;
+static List* killQueue;
+static List* faultQueue;
+static List* ioQueue;
+static List* sleepQueue;
+static List* chanSendQueue;
+static List* chanRecvQueue;
+static List* topicQueue;
+static List* topicWakeQueue;
+static List* dlQueue;       // Ready deadline processes, earliest deadline first
+static List* rtQueue;       // Ready FIFO and RR processes, highest real-time priority first
+static List* throttleQueue; // Deadline processes that used up their runtime, waiting for their next period
+static semaphore sem[5];
+static PCB* init;
+static PCB* curr;
+static bool sysRunning = true;
+static long simTime = 0;    // Simulated time in ticks, advanced by the event loop
+static long quantumLength[3] = {1, 1, 1};  // Ticks in a time quantum for each priority level
+static long quantumEnd = 0;     // Time the running process' quantum expires
+static long runStart = 0;       // Time the running process was dispatched or last accounted
+static long busyTime = 0;       // Ticks the CPU spent running processes other than init
+static int completedJobs = 0;   // Processes that finished their burst workload
+static Burst* arrivalBurst = NULL;  // Burst model given to processes created by arrivals
+static int dispatchCount = 0;   // Number of dispatches, lets stale quantum expiry events be ignored
+static int burstStamps = 0;     // Burst completion events scheduled, stamps each one with a new generation
+// Pending quantum expiry and burst completion of the running process, cancelled once a new dispatch supersedes them
+static Event_timer quantumTimer = EVENT_TIMER_INIT;
+static Event_timer burstTimer = EVENT_TIMER_INIT;
+static long boostPeriod = 0;    // Ticks between priority boosts, 0 = no periodic boost
+static int boostEpoch = 0;      // Bumped when the period changes, lets stale boost events be ignored
+static long starveThreshold = 0;    // Ready ticks after which a starvation alarm is raised, 0 = never
+static int cgRunning = CG_FAIL;     // Cgroup the running process is counted as runnable in
+static Waitq readyWaiters[3];   // Processes on each normal ready queue by readySince, the longest waiter first
+static bool waitsIncomplete = false;    // A ready process could not be tracked since alarms were turned on
+// Context switch cost model, all in ticks
+static long switchOverhead = 0; // Fixed cost of saving and restoring a process
+static long cacheRefill = 0;    // Cache warm-up cost of a process whose cache has gone completely cold
+static long cacheDecay = 0;     // Time off the CPU after which a process' cache is completely cold
+static long tlbFlush = 0;       // Cost of switching to a different address space
+static bool preemptive = false;    // Whether a higher priority wakeup preempts a running normal process
+static long wakeupGranularity = 0;  // Ticks a process runs before a normal wakeup may preempt it
+static long dispatchTime = 0;       // Time the running process was dispatched
+static int preemptArmed = 0;        // Dispatch for which a deferred preemption check is scheduled
+static int preemptions = 0;
+static int lastPid = -1;        // Last process other than init to hold the CPU, its address space is still loaded
+static long switchTime = 0;     // Ticks spent switching instead of running processes
+static int switchCount = 0;     // Context switches that were charged for
+static double dlBandwidth = 0;  // CPU share reserved by admitted deadline processes
+static int dlCount = 0;         // Live deadline processes
+static int dlMisses = 0;        // Deadline misses over the whole run
+static int cpuSpeed = 100;      // Speed of the current P-state, percent of full speed
+static long lastSwitchCost = 0; // Switch cost of the last dispatch, refunded if the switch is cut short
+
+// Queues watched for snapshots, in Totalinfo order, followed by the semaphore queues
+static List** const snapLists[SNAP_LISTS] = {&dlQueue, &rtQueue, &highQueue, &medQueue, &lowQueue, &recvQueue,
+    &sendQueue, &waitQueue, &faultQueue, &sleepQueue, &chanSendQueue, &chanRecvQueue, &topicQueue, &ioQueue,
+    &suspendQueue, &throttleQueue};
+static const char* const snapNames[SNAP_QUEUES] = {"deadline", "realtime", "high", "medium", "low", "receive",
+    "send", "wait", "fault", "sleep", "chansend", "chanrecv", "topic", "io", "suspend", "throttle",
+    "sem0", "sem1", "sem2", "sem3", "sem4"};
+static long snapTime = -1;      // Time of the last snapshot, -1 if none has been taken
+static PCB* snapRunner = NULL;  // Process that was running at the last snapshot, NULL once it is freed
+static Snap_change* snapChanges = NULL; // Processes that changed queue since the last snapshot
+static int snapCount = 0;
+static int snapCapacity = 0;
+static bool snapIncomplete = false; // A change could not be recorded, the next diff misses it
+
+static SCHED_EVENT_FN eventFn = NULL; // Event callback of an embedding program
+static void* eventContext = NULL;
+static bool reportsOn = true;   // Whether commands print their results
+
+// Prints a report on stdout unless reports are turned off
+static void report(const char* format, ...) {
+    if(!reportsOn)
+        return;
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void start_simulator(){
+    report("Starting simulator...\n");
+    // 3 ready queues of different priorities
+    highQueue = List_create();
+    medQueue = List_create();
+    lowQueue = List_create();
+    
+    // 2 wait queues for blocked processes
+    // List of blocked processes waiting for a message to be sent
+    recvQueue = List_create();
+    // List of blocked processes that sent a message and are waiting for a reply
+    sendQueue = List_create();
+    // List of processes whose group has been suspended
+    suspendQueue = List_create();
+    // List of blocked processes waiting for a child to exit
+    waitQueue = List_create();
+    // Processes taken out of the system by a group kill, terminated once the sweep is done
+    killQueue = List_create();
+    // List of blocked processes waiting for a page fault to be serviced
+    faultQueue = List_create();
+    // List of blocked processes waiting for an I/O device to complete their request
+    ioQueue = List_create();
+    // List of blocked processes in a timed I/O burst of their workload
+    sleepQueue = List_create();
+    // Lists of blocked processes waiting for room in, or a message on, a channel
+    chanSendQueue = List_create();
+    chanRecvQueue = List_create();
+    // List of blocked processes waiting for a publication on a topic they subscribe to
+    topicQueue = List_create();
+    // Receivers readied by a publication, woken together once the topic queue has been swept
+    topicWakeQueue = List_create();
+    // Ready queues of the real-time classes, ahead of the 3 priority levels
+    dlQueue = List_create();
+    rtQueue = List_create();
+    // List of deadline processes throttled until their next period
+    throttleQueue = List_create();
+
+    if(!(highQueue && medQueue && lowQueue && recvQueue && sendQueue && suspendQueue && waitQueue && killQueue &&
+        faultQueue && ioQueue && sleepQueue && chanSendQueue && chanRecvQueue && topicQueue && topicWakeQueue &&
+        dlQueue && rtQueue && throttleQueue)) {
+        report("Queue creation error.\n");
+        return;
+    } else
+        report("Success: 3 ready queues, 9 wait queues, 1 suspend queue created\n");
+
+    Dev_init();
+    report("Success: Block device 0 and network device 1 created\n");
+    Mem_configure(MEM_DEFAULT_FRAMES, MEM_LRU, MEM_DEFAULT_LATENCY);
+    Mem_set_window(MEM_DEFAULT_WINDOW);
+    Event_clear();
+    Fair_reset();
+    Cg_reset();
+    cgRunning = CG_FAIL;
+    Energy_reset(simTime);
+
+    // Create 5 semaphores with initial value -1
+    for(int i = 0; i < 5; i++) {
+        sem[i].value = -1;
+        sem[i].active = false;
+        sem[i].holders = 0;
+        sem[i].holderSum = 0;
+        sem[i].owner = NULL;
+        Wfg_init(&sem[i].wait, WFG_SEMAPHORE, i);
+        sem[i].order = WAITQ_FIFO;
+        Waitq_init(&sem[i].waiters);
+        sem[i].semQueue = List_create();
+        if(sem[i].semQueue == NULL) {
+            report("Error: Failed to create semaphore\n");
+            return;
+        } else
+            report("Success: Created semaphore %d\n", i);
+        List_watch(sem[i].semQueue, &queue_changed, (void*)(intptr_t)(SNAP_LISTS + i));
+    }
+    for(int i = 0; i < SNAP_LISTS; i++)
+        List_watch(*snapLists[i], &queue_changed, (void*)(intptr_t)i);
+    for(int i = LOW; i <= HIGH; i++)
+        Waitq_init(&readyWaiters[i]);
+
+    // Init process only runs when no other processes are ready to execute, but it never blocks
+    // Init process cannot be killed or exited unless it is the last process in the system
+    // after which the simulation terminates
+    init = PCB_create(-1);  // -1 = no priority, init passes control to process next on the ready queue
+    if(!init) {
+        report("Error: Failied to create init process\n");
+        return;
+    }
+    init->PID = 0;
+    if(PCB_write_cold(init) == NULL) {  // Init is always running, so it owns its cold part
+        PCB_free(init);
+        init = NULL;
+        report("Error: Failied to create init process\n");
+        return;
+    }
+    init->cold->groupID = 0;
+    init->pState = RUNNING;
+    curr = init;
+    report("Running: Process init\n");
+}
+
+void stop_simulator() {
+    FREE_FN free_fn = &free_item;
+    List_free(highQueue, free_fn);
+    List_free(medQueue, free_fn);
+    List_free(lowQueue, free_fn);
+    List_free(recvQueue, free_fn);
+    List_free(sendQueue, free_fn);
+    List_free(suspendQueue, free_fn);
+    List_free(waitQueue, free_fn);
+    List_free(killQueue, free_fn);
+    List_free(faultQueue, free_fn);
+    List_free(ioQueue, free_fn);
+    List_free(sleepQueue, free_fn);
+    for(int i = 0; i < 5; i++) {
+        List_free(sem[i].semQueue, free_fn);
+    }
+    Burst_free(arrivalBurst);
+    arrivalBurst = NULL;
+    List_free(chanSendQueue, free_fn);
+    List_free(chanRecvQueue, free_fn);
+    Chan_close_all();
+    List_free(topicQueue, free_fn);
+    List_free(topicWakeQueue, free_fn);
+    Topic_close_all();
+    List_free(dlQueue, free_fn);
+    List_free(rtQueue, free_fn);
+    List_free(throttleQueue, free_fn);
+    free(snapChanges);
+    snapChanges = NULL;
+    snapCount = snapCapacity = 0;
+    snapTime = -1;
+    snapRunner = NULL;
+    snapIncomplete = false;
+    PCB_pool_free();    // Every PCB, live or not, goes back to the heap with its pool
+}
+
+bool Sched_running() {
+    return sysRunning;
+}
+
+long Sched_time() {
+    return simTime;
+}
+
+int Sched_current() {
+    return curr->PID;
+}
+
+void Sched_on_event(SCHED_EVENT_FN fn, void* context) {
+    eventFn = fn;
+    eventContext = context;
+}
+
+void Sched_set_reports(bool on) {
+    reportsOn = on;
+}
+
+int Sem_order(int semID) {
+    if(semID < 0 || semID > 4)
+        return SCHED_FAIL;
+    return sem[semID].order;
+}
+
+int Create(int priority) {
+    PCB* process = create_process(priority, NULL);
+    if(process == NULL)
+        return SCHED_FAIL;
+    check_preempt();
+    return process->PID;
+}
+
+int Create_rt(int policy, int rtPriority) {
+    if((policy != POLICY_FIFO && policy != POLICY_RR) || rtPriority < RT_MIN_PRIORITY || rtPriority > RT_MAX_PRIORITY) {
+        report("Error: Invalid real-time policy or priority [Valid priority = %d to %d]. Returning to Main Menu...\n",
+            RT_MIN_PRIORITY, RT_MAX_PRIORITY);
+        return SCHED_FAIL;
+    }
+    PCB* process = create_policy_process(policy, rtPriority, 0, 0, 0);
+    if(process == NULL)
+        return SCHED_FAIL;
+    dispatch_if_idle();
+    return process->PID;
+}
+
+int Create_deadline(long runtime, long deadline, long period) {
+    if(runtime < 1 || deadline < runtime || period < 1) {
+        report("Error: Invalid deadline parameters, runtime must be at least 1 tick and within the deadline. "
+            "Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    double share = (double)runtime / (deadline < period ? deadline : period);
+    if(dlBandwidth + share > DL_MAX_BANDWIDTH + 1e-9) {
+        report("Error: Admission denied, %.1f%% more would exceed the %.0f%% deadline bandwidth (%.1f%% reserved). "
+            "Returning to Main Menu...\n", 100 * share, 100 * DL_MAX_BANDWIDTH, 100 * dlBandwidth);
+        return SCHED_FAIL;
+    }
+    PCB* process = create_policy_process(POLICY_DEADLINE, 0, runtime, deadline, period);
+    if(process == NULL)
+        return SCHED_FAIL;
+    dispatch_if_idle();
+    return process->PID;
+}
+
+int Fork() {
+    if(curr->PID == 0) {  // Cannot fork init process
+        report("Error: Cannot fork init process. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(curr->policy == POLICY_DEADLINE) {   // The child would need a reservation of its own
+        report("Error: Cannot fork a deadline process. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    account_cpu();  // Child starts with what is left of the parent's CPU burst
+    PCB* fp = fork_process(curr);
+    if(fp == NULL) {
+        report("Error: Fork failed. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Fork: process %d created\n", fp->PID);
+    return fp->PID;
+}
+
+int Kill(int pid) {
+    if(curr->PID == pid) {   // Kill current process in Exit()
+        return Exit();
+    } else if(pid == 0) {   // Cannot kill init process
+        report("Error: Cannot terminate init process. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    } else {    // Search and kill process
+        List* searchQueue = search_process(pid);
+        if(searchQueue) {
+            for(int i = 0; i < 5; i++) {    // Case: Kill process blocked on semaphore and increment semaphore value
+                if(searchQueue == sem[i].semQueue) {
+                    report("The process was blocked on Semaphore %d\n", i);
+                    report("Incrementing Semaphore value by 1\n");
+                    sem[i].value += 1;
+                    report("Semaphore %d now has value %d\n", i, sem[i].value);
+                    Waitq_remove(&sem[i].waiters, &((PCB*)List_curr(searchQueue))->cold->sync->semWait);
+                }
+            }
+
+            terminate_process(List_remove(searchQueue)); // Free process
+            report("Success: Terminated Process %d\n", pid);
+            check_preempt();    // A parent waiting for the process may have woken up
+        } else {
+            report("Error: Process %d not found\n", pid);
+            return SCHED_FAIL;
+        }
+    }
+    return SCHED_SUCCESS;
+}
+
+int Exit() {
+    // Cannot exit init process if there are other processes in the system
+    if(curr->PID == 0) {
+        if(List_count(highQueue) > 0 || List_count(medQueue) > 0 || List_count(lowQueue) > 0 || 
+            List_count(sem[0].semQueue) > 0 || List_count(sem[1].semQueue) > 0 || List_count(sem[2].semQueue) > 0 ||
+            List_count(sem[3].semQueue) > 0 || List_count(sem[4].semQueue) > 0 || List_count(recvQueue) > 0 ||
+            List_count(sendQueue) > 0 || List_count(suspendQueue) > 0 || List_count(waitQueue) > 0 ||
+            List_count(faultQueue) > 0 || List_count(ioQueue) > 0 || List_count(sleepQueue) > 0 ||
+            List_count(chanSendQueue) > 0 || List_count(chanRecvQueue) > 0 || List_count(topicQueue) > 0 ||
+            List_count(dlQueue) > 0 || List_count(rtQueue) > 0 || List_count(throttleQueue) > 0) {
+            report("Error: Cannot exit init process. Returning to Main Menu...\n");
+            return SCHED_FAIL;
+        }
+        release_process(init);
+        report("Success: Init process terminated. Shutting down...\n");
+        sysRunning = false;
+        return SCHED_SUCCESS;
+    }
+    // Free current process
+    account_cpu();
+    terminate_process(curr);
+    curr = NULL;
+    report("Success: Terminated current process\n");
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Quantum() {
+    report("Time quantum reached...\n");
+    if(curr->policy == POLICY_FIFO) {   // FIFO processes have no quantum, they yield instead
+        if(!reserve_curr("yielding"))
+            return SCHED_FAIL;
+        report("Process %d yields the CPU\n", curr->PID);
+        make_ready(curr);
+        switch_process();
+    } else if(curr != init)    // The expiry event of the running process ends the run
+        run_until(quantumEnd);
+    else {
+        run_until(simTime + quantum_length(MED));
+        if(curr == init)
+            report("Runnig: init\n");
+    }
+    return SCHED_SUCCESS;
+}
+
+int Arrival(int priority, long delay) {
+    if(priority < LOW || priority > HIGH || delay < 0) {
+        report("Error: Invalid input. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(!schedule(simTime + delay, EV_ARRIVAL, priority, "the process arrival"))
+        return SCHED_FAIL;
+    report("Success: Process arrival scheduled at time %ld\n", simTime + delay);
+    return SCHED_SUCCESS;
+}
+
+int Set_burst_script(int pid, char* script, int device) {
+    PCB* process = find_process(pid);
+    if(process == NULL || process == init) {
+        report("Error: Process %d not found. Returning to Main Menu...\n", pid);
+        return SCHED_FAIL;
+    }
+    Burst* model = Burst_parse(script, device);
+    if(model == NULL) {
+        report("Error: Invalid burst script (at most %d positive CPU bursts and non-negative I/O bursts). "
+            "Returning to Main Menu...\n", (BURST_MAX_SCRIPT + 1) / 2);
+        return SCHED_FAIL;
+    }
+    if(attach_burst(process, model) != SCHED_SUCCESS)
+        return SCHED_FAIL;
+    report("Success: Process %d runs a scripted workload of %d CPU burst(s)\n", pid, (model->length + 1) / 2);
+    return SCHED_SUCCESS;
+}
+
+int Set_burst_random(int pid, long meanCpu, long meanIo, int count, int device) {
+    PCB* process = find_process(pid);
+    if(process == NULL || process == init) {
+        report("Error: Process %d not found. Returning to Main Menu...\n", pid);
+        return SCHED_FAIL;
+    }
+    Burst* model = Burst_random(meanCpu, meanIo, count, device);
+    if(model == NULL) {
+        report("Error: Invalid burst model. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(attach_burst(process, model) != SCHED_SUCCESS)
+        return SCHED_FAIL;
+    report("Success: Process %d runs a random workload of %d CPU burst(s)\n", pid, count);
+    return SCHED_SUCCESS;
+}
+
+int Import_trace(char* path, long usPerTick) {
+    if(usPerTick < 1) {
+        report("Error: A tick must be at least 1 microsecond. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    Trace* trace = Trace_open(path);
+    if(trace == NULL) {
+        report("Error: Cannot open text trace %s (convert perf.data with perf sched script). "
+            "Returning to Main Menu...\n", path);
+        return SCHED_FAIL;
+    }
+    Trace_event ev;
+    long origin = -1;   // Trace time of the first event, mapped to the current time
+    long start = simTime;
+    long events = 0;
+    int result = TRACE_END;
+    while(sysRunning && (result = Trace_next(trace, &ev)) == TRACE_EVENT) {
+        if(origin < 0)
+            origin = ev.time;
+        run_until(start + (ev.time - origin) / usPerTick);
+        apply_trace_event(trace, &ev);
+        dispatch_if_idle();
+        events++;
+    }
+    if(result == TRACE_FAIL)
+        report("Error: Failed to map %s, import stopped\n", path);
+    report("Success: Imported %ld scheduler event(s) (%ld other line(s) skipped), time is now %ld\n",
+        events, Trace_skipped(trace), simTime);
+    Trace_close(trace);
+    return result == TRACE_FAIL ? SCHED_FAIL : SCHED_SUCCESS;
+}
+
+int Boost() {
+    int boosted = boost_queue(medQueue) + boost_queue(lowQueue);
+    List_splice(highQueue, medQueue);
+    List_splice(highQueue, lowQueue);
+    if(curr != init && curr->policy == POLICY_NORMAL && curr->priority != HIGH) {
+        curr->boostedFrom = curr->priority;
+        curr->priority = HIGH;
+        boosted++;
+    }
+    report("Success: Boosted %d process(es) to high priority\n", boosted);
+    return SCHED_SUCCESS;
+}
+
+// Raises every process on a lower ready queue to high priority until its next quantum expires, in O(n)
+int boost_queue(List* queue) {
+    for(PCB* process = List_first(queue); process != NULL; process = List_next(queue)) {
+        if(process->boostedFrom < 0)
+            process->boostedFrom = process->priority;
+        process->priority = HIGH;
+    }
+    return List_count(queue);
+}
+
+int Configure_boost(long period) {
+    if(period < 0) {
+        report("Error: Invalid boost period. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    boostPeriod = period;
+    boostEpoch++;   // Drop the boost scheduled with the old period
+    if(period > 0 && !schedule(simTime + period, EV_BOOST, boostEpoch, "the first priority boost")) {
+        boostPeriod = 0;    // Nothing is scheduled, the boost stays off
+        return SCHED_FAIL;
+    }
+    if(period > 0)
+        report("Success: Priorities are boosted every %ld ticks\n", period);
+    else
+        report("Success: Periodic priority boost disabled\n");
+    return SCHED_SUCCESS;
+}
+
+int Configure_starvation(long threshold) {
+    if(threshold < 0) {
+        report("Error: Invalid starvation threshold. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(threshold == 0) {    // The nodes stay with their processes for the next time alarms are on
+        for(int level = LOW; level <= HIGH; level++) {
+            Waitq_node* node;
+            while((node = Waitq_pop(&readyWaiters[level])) != NULL)
+                node->pos = NULL;
+        }
+    }
+    bool tracking = starveThreshold > 0;
+    starveThreshold = threshold;
+    if(threshold > 0 && !tracking) {    // Start tracking the processes already waiting
+        waitsIncomplete = false;
+        for(int level = LOW; level <= HIGH; level++) {
+            List* queue = ready_queue(level);
+            for(PCB* process = List_first(queue); process != NULL; process = List_next(queue))
+                track_ready(process, level, true);
+        }
+    }
+    if(threshold > 0)
+        report("Success: Ready processes raise a starvation alarm after %ld ticks\n", threshold);
+    else
+        report("Success: Starvation alarms disabled\n");
+    return SCHED_SUCCESS;
+}
+
+int Cgroup_create(char* name, char* parent, int weight) {
+    int parentID = Cg_find(parent);
+    if(parentID == CG_FAIL) {
+        report("Error: Cgroup %s not found. Returning to Main Menu...\n", parent);
+        return SCHED_FAIL;
+    }
+    if(Cg_create(name, parentID, weight) == CG_FAIL) {
+        report("Error: Cannot create cgroup %s (name taken or too long, weight outside 1 to %d or %d groups in use). "
+            "Returning to Main Menu...\n", name, CG_MAX_WEIGHT, CG_MAX_GROUPS);
+        return SCHED_FAIL;
+    }
+    report("Success: Cgroup %s created under %s with weight %d\n", name, parent, weight);
+    return SCHED_SUCCESS;
+}
+
+int Cgroup_limit(char* name, long quota, long period) {
+    int id = Cg_find(name);
+    if(id == CG_FAIL || id == CG_ROOT) {
+        report("Error: Cgroup %s not found or is the root. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    int timer = Cg_set_max(id, quota, period, simTime);
+    if(timer == CG_FAIL) {
+        report("Error: Invalid quota or period. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(quota > 0 && !schedule(simTime + period, EV_CG_REFILL, timer, "the cgroup refill")) {
+        Cg_cancel(timer, simTime);  // A limit that is never refilled would hold the group back for good
+        return SCHED_FAIL;
+    } else if(quota > 0)
+        report("Success: Cgroup %s may run %ld tick(s) every %ld\n", name, quota, period);
+    else
+        report("Success: Cgroup %s is no longer limited\n", name);
+    release_throttled();    // The group starts with a full quota
+    dispatch_if_idle();
+    return SCHED_SUCCESS;
+}
+
+int Cgroup_attach(int pid, char* name) {
+    int id = Cg_find(name);
+    if(id == CG_FAIL) {
+        report("Error: Cgroup %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    PCB* process = find_process(pid);
+    if(process == NULL || process == init) {
+        report("Error: Process %d not found. Returning to Main Menu...\n", pid);
+        return SCHED_FAIL;
+    }
+    if(process->policy == POLICY_DEADLINE && id != CG_ROOT) {
+        report("Error: Deadline processes cannot be limited by a cgroup. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(process == curr)
+        account_cpu();  // Time run so far belongs to the old group
+    Cg_detach(process->cgroup);
+    if(process->queue >= 0 && process->queue < SNAP_READY_LISTS) {  // Runnable count moves with it
+        Cg_runnable(process->cgroup, -1);
+        Cg_runnable(id, 1);
+    } else if(process == curr) {
+        Cg_runnable(cgRunning, -1);
+        cgRunning = id;
+        Cg_runnable(id, 1);
+    }
+    process->cgroup = id;
+    Cg_attach(id);
+    report("Success: Process %d moved to cgroup %s\n", pid, name);
+    release_throttled();    // The process may have left a throttled group
+    dispatch_if_idle();
+    return SCHED_SUCCESS;
+}
+
+int Configure_preemption(bool on, long granularity) {
+    if(granularity < 0) {
+        report("Error: Invalid wakeup granularity. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    preemptive = on;
+    wakeupGranularity = granularity;
+    if(on)
+        report("Success: Preemptive mode on, wakeups preempt after %ld tick(s) of running\n", granularity);
+    else
+        report("Success: Preemptive mode off, wakeups wait for the quantum to expire\n");
+    check_preempt();
+    return SCHED_SUCCESS;
+}
+
+int Configure_switch_cost(long overhead, long cache, long decay, long tlb) {
+    if(overhead < 0 || cache < 0 || decay < 0 || tlb < 0) {
+        report("Error: Invalid context switch cost. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    switchOverhead = overhead;
+    cacheRefill = cache;
+    cacheDecay = decay;
+    tlbFlush = tlb;
+    report("Success: Context switches cost %ld tick(s), up to %ld more for a cache cold after %ld tick(s) and %ld for a TLB flush\n",
+        overhead, cache, decay, tlb);
+    return SCHED_SUCCESS;
+}
+
+int Snapshot(char* path) {
+    FILE* file = fopen(path, "w");
+    if(file == NULL) {
+        report("Error: Cannot open %s. Returning to Main Menu...\n", path);
+        return SCHED_FAIL;
+    }
+    int queued = 0;
+    fprintf(file, "{\"time\": %ld, \"running\": %d, \"queues\": {", simTime, curr->PID);
+    for(int i = 0; i < SNAP_QUEUES; i++) {
+        List* queue = i < SNAP_LISTS ? *snapLists[i] : sem[i - SNAP_LISTS].semQueue;
+        fprintf(file, "%s\"%s\": [", i > 0 ? ", " : "", snapNames[i]);
+        PCB* process = List_first(queue);
+        for(int n = 0; process != NULL; n++) {
+            fprintf(file, "%s%d", n > 0 ? ", " : "", process->PID);
+            queued++;
+            process = List_next(queue);
+        }
+        fprintf(file, "]");
+    }
+    fprintf(file, "}}\n");
+    bool failed = ferror(file) != 0;
+    if(fclose(file) != 0 || failed) {  // The old baseline stays in place
+        report("Error: Failed to write %s. Returning to Main Menu...\n", path);
+        return SCHED_FAIL;
+    }
+    // The file is written, the changes recorded so far are folded into the new baseline
+    if(snapRunner && snapRunner != curr)
+        snapRunner->snapQueue = snapRunner->queue;
+    for(int i = 0; i < snapCount; i++) {
+        PCB* process = snap_find(snapChanges[i].pid);
+        if(process) {
+            process->snapQueue = process->queue;
+            process->snapChanged = false;
+        }
+    }
+    snapCount = 0;
+    for(int i = 0; i < SNAP_QUEUES; i++) {
+        List* queue = i < SNAP_LISTS ? *snapLists[i] : sem[i - SNAP_LISTS].semQueue;
+        for(PCB* process = List_first(queue); process != NULL; process = List_next(queue))
+            process->snapQueue = process->queue;
+    }
+    snapIncomplete = false;
+    curr->snapQueue = SNAP_RUNNING;
+    snapRunner = curr;
+    snapTime = simTime;
+    report("Success: Snapshot of %d queued process(es) at time %ld written to %s\n", queued, simTime, path);
+    return SCHED_SUCCESS;
+}
+
+int Snapshot_diff() {
+    if(snapTime < 0) {
+        report("Error: No snapshot has been taken. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    // Dispatches change the running process without touching a queue
+    if(snapRunner)
+        snap_changed(snapRunner);
+    snap_changed(curr);
+    report("Changes since the snapshot at time %ld:\n", snapTime);
+    int changed = 0;
+    for(int i = 0; i < snapCount; i++) {
+        Snap_change* change = &snapChanges[i];
+        PCB* process = snap_find(change->pid);
+        int now = process == NULL ? SNAP_EXITED : process == curr ? SNAP_RUNNING : process->queue;
+        if(now == change->from || (change->from == PCB_NOT_SNAPPED && now == SNAP_EXITED))
+            continue;   // Back where it was, or came and went between snapshots
+        report("\tProcess %d: %s -> %s\n", change->pid, snap_name(change->from), snap_name(now));
+        changed++;
+    }
+    if(snapIncomplete) {
+        report("Error: Out of memory while tracking changes, these %d are not all the changes since time %ld. Take a new snapshot\n",
+            changed, snapTime);
+        return SCHED_FAIL;
+    }
+    report("Success: %d process(es) changed queue since time %ld\n", changed, snapTime);
+    return SCHED_SUCCESS;
+}
+
+int Configure_pstates(int count, int* speed, int* power) {
+    if(Energy_set_pstates(simTime, count, speed, power) != ENERGY_SUCCESS) {
+        report("Error: Invalid P-state table, speeds must fall from 100 to 1 percent. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: %d P-state(s) set, from %d%% to %d%% speed\n", count, speed[0], speed[count - 1]);
+    return SCHED_SUCCESS;
+}
+
+int Configure_cstates(int count, int* power, int* latency, int* residency) {
+    if(Energy_set_cstates(simTime, count, power, latency, residency) != ENERGY_SUCCESS) {
+        report("Error: Invalid C-state table, deeper states must draw less power and need longer residency. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: %d C-state(s) set, the deepest wakes in %d tick(s)\n", count, latency[count - 1]);
+    return SCHED_SUCCESS;
+}
+
+int Configure_governor(int governor) {
+    static const char* names[] = {"performance", "powersave", "ondemand"};
+    if(Energy_set_governor(governor) != ENERGY_SUCCESS) {
+        report("Error: Invalid governor. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: Frequency governor set to %s\n", names[governor]);
+    return SCHED_SUCCESS;
+}
+
+int Configure_arrivals(Burst* model) {
+    Burst_free(arrivalBurst);
+    arrivalBurst = model;
+    if(model)
+        report("Success: Arriving processes run %d random CPU burst(s) (mean %ld, I/O mean %ld)\n",
+            model->count, model->meanCpu, model->meanIo);
+    else
+        report("Success: Arriving processes have no burst workload\n");
+    return SCHED_SUCCESS;
+}
+
+int Run(long duration) {
+    if(duration < 0) {
+        report("Error: Invalid input. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int handled = run_until(simTime + duration);
+    report("Success: Handled %d event(s), time is now %ld (%d event(s) pending)\n", handled, simTime, Event_count());
+    if(simTime > 0)
+        report("CPU utilisation: %.1f%%, throughput: %.4f jobs/tick (%d completed)\n",
+            100.0 * busyTime / simTime, (double)completedJobs / simTime, completedJobs);
+    if(simTime > 0 && switchCount > 0)
+        report("Context switches: %d, %ld tick(s) switching (%.1f%% of time)\n", switchCount, switchTime,
+            100.0 * switchTime / simTime);
+    if(preemptions > 0)
+        report("Preemptions: %d\n", preemptions);
+    if(dlCount > 0 || dlMisses > 0)
+        report("Deadline misses: %d\n", dlMisses);
+    if(reportsOn) {
+        print_fairness();
+        Energy_print_stats(simTime, completedJobs);
+    }
+    return SCHED_SUCCESS;
+}
+
+int Configure_quantum(int priority, long length) {
+    if(length < 1 || priority < LOW || priority > HIGH + 1) {
+        report("Error: Invalid input, quantum length must be at least 1 tick. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    for(int level = LOW; level <= HIGH; level++) {
+        if(priority == level || priority == HIGH + 1)
+            quantumLength[level] = length;
+    }
+    report("Success: Quantum lengths (low/medium/high) are %ld/%ld/%ld ticks\n",
+        quantumLength[LOW], quantumLength[MED], quantumLength[HIGH]);
+    return SCHED_SUCCESS;
+}
+
+// Ends the running process' quantum
+void expire_quantum() {
+    report("Time %ld: Quantum of process %d expired\n", simTime, curr->PID);
+    if(curr != init)
+        account_cpu();  // Charge the slice to the reservation and cgroup before checking what is left
+    if(curr != init && !reserve_curr("leaving the CPU")) {
+        if(curr->policy == POLICY_DEADLINE && curr->cold->dl->budget <= 0)
+            set_deadline(curr, simTime + curr->cold->dl->deadline);   // Its next reservation starts now instead
+        start_quantum();
+        return;
+    }
+    if(curr->policy == POLICY_DEADLINE && curr->cold->dl->budget <= 0) {
+        throttle_curr();
+        return;
+    }
+    if(curr != init && Cg_throttled(curr->cgroup)) {
+        park_curr();
+        return;
+    }
+    if(curr != init) {
+        // Lower priority of current process
+        // if(curr->priority == HIGH) {
+        //     curr->priority = MED;
+        //     List_append(medQueue, curr);
+        //     printf("Priority changed to medium(MED)\n");
+        // } else if(curr->priority == MED) {
+        //     curr->priority = LOW;
+        //     List_append(lowQueue, curr);
+        //     printf("Priority changed to low(LOW)\n");
+        // } else
+        //     List_append(lowQueue, curr);
+        if(curr->boostedFrom >= 0) {    // The boost lasts one quantum
+            curr->priority = curr->boostedFrom;
+            curr->boostedFrom = -1;
+        }
+        make_ready(curr);   // Back of its ready queue (round robin)
+        // pick next current from ready processes; switch to init if none
+        switch_process();
+    }
+}
+
+int Send(int pid, char* msg) {
+    PCB* target = NULL;
+    List* searchQueue = NULL;
+    // Search for process
+    if(pid == curr->PID) {
+        report("Error: Cannot send message to self. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    } else if(pid == 0) {
+        target = init;
+    } else {
+        searchQueue = search_process(pid);
+        if(searchQueue) {
+            target = List_curr(searchQueue);
+            if(target->pState == BLOCKED && searchQueue != recvQueue) {   // Only receivers can take a message while blocked
+                report("Error: Process %d is blocked. Returning to Main Menu...\n", pid);
+                return SCHED_FAIL;
+            }
+        } else {
+            report("Error: Process %d not found. Returning to Main Menu...\n", pid);
+            return SCHED_FAIL;
+        }
+    }
+    // The sender waits for the target in the wait-for graph
+    if(curr != init && (PCB_get_sync(curr) == NULL || PCB_get_sync(target) == NULL)) {
+        report("Error: Out of memory for the wait-for graph. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    // Writing the message gives the target its own copy of any buffers shared with a fork
+    if(curr != init && List_reserve(1) != LIST_SUCCESS) {    // The sender blocks on the send queue
+        report("Error: Out of memory for the send queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    PCB_msgs* targetMsgs = PCB_write_msgs(target);
+    if(targetMsgs == NULL) {
+        report("Error: Out of memory for message buffers. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    // If current is not init, block current process
+    if(curr != init) {
+        curr->pState = BLOCKED;
+        List_append(sendQueue, curr);
+        report("Success: Process %d sent a message and is now blocked. \nWaiting for reply...\n", curr->PID);
+        wait_for(curr, &target->cold->sync->wait);
+    } else 
+        report("Success: Process %d sent a message. Cannot block init process\n", curr->PID);
+    
+    // If recipient is in blocked queue, unblock and copy message to display
+    if(searchQueue == recvQueue) {
+        target->pState = READY; // Unblock process
+        strncpy(targetMsgs->recv_msg, msg, MAX_MSG);
+        target->cold->senderPID = curr->PID;
+        // sprintf(target->send_msg, "Process %d sent a message: %s\n", curr->PID, target->recv_msg);
+        // target->recv_msg[0] = '\0'; // Clear message to prevent duplicates
+
+        List_remove(recvQueue);
+        report("Success: Process %d received a message, process ublocked\n", target->PID);
+        make_ready(target);
+    } else {    // If recipient is not in blocked queue, copy message and sender
+        strncpy(targetMsgs->recv_msg, msg, MAX_PROCESS_MSG);
+        target->cold->senderPID = curr->PID;
+        report("Success: Process %d received a message\n", target->PID);
+    }
+    if(curr != init)    // Sender is blocked waiting for the reply
+        switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Receive() {
+    if(curr->cold->msgs->recv_msg[0] != '\0') {
+        PCB_msgs* msgs = PCB_write_msgs(curr);  // Clearing the message needs a private copy of shared buffers
+        if(msgs == NULL) {  // Left in place so it can be received again
+            report("Error: Out of memory for message buffers. Returning to Main Menu...\n");
+            return SCHED_FAIL;
+        }
+        report("Process %d sent a message: %s\n", curr->cold->senderPID, msgs->recv_msg);
+        msgs->recv_msg[0] = '\0'; // Clear message to prevent duplicates
+        curr->cold->senderPID = -1;   // Clear senderPID
+    } else {    // If no message, block process unless it is init
+        if(curr != init) {
+            if(List_reserve(1) != LIST_SUCCESS) {
+                report("Error: Out of memory for the receive queue. Returning to Main Menu...\n");
+                return SCHED_FAIL;
+            }
+            curr->pState = BLOCKED;
+            List_append(recvQueue, curr);
+            report("No messages: Process %d is now blocked. Waiting for message...\n", curr->PID);
+            switch_process();
+        } else
+            report("No messages: Cannot block init process. Returning to Main Menu...\n");
+    }
+    return SCHED_SUCCESS;
+}
+
+int Reply(int pid, char* msg) {
+    // Search for process using PID
+    if(pid == curr->PID) {
+        report("Error: Cannot reply to self. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+
+    PCB* sender = NULL;
+    if(pid == 0) {
+        sender = init;
+    } else {
+        List* searchQueue = search_process(pid);
+        if(searchQueue == sendQueue) {  // Sender is blocked waiting for this reply
+            sender = List_curr(searchQueue);
+        } else if(searchQueue) {
+            report("Error: Process %d has not sent a message. Returning to Main Menu...\n", pid);
+            return SCHED_FAIL;
+        } else {
+            report("Error: Process %d not found. Returning to Main Menu...\n", pid);
+            return SCHED_FAIL;
+        }
+    }
+    PCB_msgs* senderMsgs = PCB_write_msgs(sender);
+    if(senderMsgs == NULL) {
+        report("Error: Out of memory for message buffers. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    // Unblock sender and copy message to display
+    sender->pState = READY; // Unblock process
+    strncpy(senderMsgs->recv_msg, msg, MAX_MSG);
+    // sprintf(sender->send_msg, "Process %d sent a message: %s\n", curr->PID, sender->recv_msg);
+    // sender->recv_msg[0] = '\0'; // Clear message to prevent duplicates
+    report("Success: Process %d received a reply\n", sender->PID);
+    
+    // If current is not init, block current process
+    if(sender != init) {
+        List_remove(sendQueue); // search_process() left the sender as the current item
+        Wfg_release(&sender->cold->sync->wait);
+        make_ready(sender);
+        dispatch_if_idle(); // Sender runs if init is running or it outranks the replying process
+    }
+    return SCHED_SUCCESS;
+}
+
+int New_sem(int semID, int value) {
+    if(semID < 0 || semID > 4) {
+        report("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(sem[semID].active) {
+        report("Error: Semaphore %d already exists. Returning to Main Menu...\n", semID);
+        return SCHED_FAIL;
+    }
+    if(value < 0) {
+        report("Error: Invalid semaphore value, value must be positive. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    sem[semID].value = value;
+    sem[semID].active = true;
+    report("Success: Semaphore %d created with value %d\n", semID, value);
+    return SCHED_SUCCESS;
+}
+
+int Sem_P(int semID, long deadline) {
+    if(semID < 0 || semID > 4) {
+        report("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(!sem[semID].active) {
+        report("Error: Semaphore %d does not exist. Returning to Main Menu...\n", semID);
+        return SCHED_FAIL;
+    }
+    // The process either holds the semaphore or waits on it
+    if(PCB_get_sync(curr) == NULL) {
+        report("Error: Out of memory for the wait-for graph. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    // Decrement semaphore value
+    sem[semID].value -= 1;
+    if(sem[semID].value > 0) {
+        report("Success: Process %d did P() on Semaphore %d (value: %d). Process is not blocked\n", curr->PID, semID, sem[semID].value);
+        sem_hold(semID, curr, 1);
+    } else {    // Semaphore value is < 0, block process
+        if(curr->PID == 0) {
+            report("Success: Process %d did P() on Semaphore %d (value: %d). Unable to block process init\n", curr->PID, semID, sem[semID].value);
+            // return;
+        } else {
+            if(sem_enqueue(semID, curr, deadline) != SCHED_SUCCESS) {
+                sem[semID].value += 1;  // The P() did not happen
+                report("Error: Out of memory for the wait queue of Semaphore %d. Returning to Main Menu...\n", semID);
+                return SCHED_FAIL;
+            }
+            report("Success: Process %d did P() on Semaphore %d (value %d). Process blocked\n", curr->PID, semID, sem[semID].value);
+            curr->pState = BLOCKED;
+            wait_for(curr, &sem[semID].wait);
+        }
+    }
+    // If current process is blocked on semaphore, switch to next process
+    if(curr->pState == BLOCKED)
+        switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Sem_V(int semID) {
+    if(semID < 0 || semID > 4) {
+        report("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(!sem[semID].active) {
+        report("Error: Semaphore %d does not exist. Returning to Main Menu...\n", semID);
+        return SCHED_FAIL;
+    }
+    // Increment semaphore value
+    sem[semID].value += 1;
+    sem_hold(semID, curr, -1);  // A V() by a process that holds no unit only raises the value
+    // Unblock process if semaphore value is <= 0
+    if(sem[semID].value <= 0) {
+        PCB* process = sem_dequeue(semID);
+        if(!process) {
+            report("Error: Semaphore %d queue is empty. Returning to Main Menu...\n", semID);
+            return SCHED_FAIL;   
+        }
+        report("Success: Process %d did V() on Semaphore %d (value: %d). Process unblocked\n", process->PID, semID, sem[semID].value);
+        process->pState = READY;
+        Wfg_release(&process->cold->sync->wait);
+        sem_hold(semID, process, 1);    // The woken process now holds the semaphore
+        
+        // Place process in ready queue, if init is running switch to new process
+        make_ready(process);
+        dispatch_if_idle();
+        process = NULL;
+    } else {
+        report("Success: Process %d did V() on Semaphore %d (value: %d). Process is not blocked\n", curr->PID, semID, sem[semID].value);
+    }
+    
+    return SCHED_SUCCESS;
+}
+
+int Chan_create(char* name, int capacity) {
+    if(Chan_open(name, capacity, simTime) == CHAN_FAIL) {
+        report("Error: Cannot open channel %s (name taken, capacity below 1 or %d channels open). "
+            "Returning to Main Menu...\n", name, CHAN_MAX_CHANNELS);
+        return SCHED_FAIL;
+    }
+    report("Success: Channel %s opened with room for %d message(s)\n", name, capacity);
+    return SCHED_SUCCESS;
+}
+
+int Chan_send(char* name, char* msg) {
+    int chanID = Chan_find(name);
+    if(chanID == CHAN_FAIL) {
+        report("Error: Channel %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    COMPARATOR_FN compare = &compare_chan;
+    List_first(chanRecvQueue);
+    PCB* receiver = List_search(chanRecvQueue, compare, &chanID);
+    if(receiver) {  // Hand the message straight to the oldest waiting receiver
+        PCB_msgs* msgs = PCB_write_msgs(receiver);
+        if(msgs == NULL) {
+            report("Error: Out of memory for message buffers. Returning to Main Menu...\n");
+            return SCHED_FAIL;
+        }
+        List_remove(chanRecvQueue);
+        strncpy(msgs->recv_msg, msg, MAX_MSG);
+        receiver->cold->senderPID = curr->PID;
+        receiver->cold->chanID = -1;
+        Chan_direct(chanID);
+        report("Success: Process %d received the message on channel %s, process unblocked\n", receiver->PID, name);
+        make_ready(receiver);
+        dispatch_if_idle();
+        return SCHED_SUCCESS;
+    }
+    if(!Chan_full(chanID)) {
+        Chan_push(chanID, curr->PID, msg, simTime);
+        report("Success: Process %d sent a message on channel %s\n", curr->PID, name);
+        return SCHED_SUCCESS;
+    }
+    Chan_backpressure(chanID);
+    if(curr == init) {
+        report("Error: Channel %s is full. Cannot block init process. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    if(List_reserve(1) != LIST_SUCCESS) {
+        report("Error: Out of memory for the channel send queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    PCB_msgs* msgs = PCB_write_msgs(curr);  // The message waits in the sender's send buffer
+    if(msgs == NULL) {
+        report("Error: Out of memory for message buffers. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    strncpy(msgs->send_msg, msg, MAX_PROCESS_MSG);
+    curr->cold->chanID = chanID;
+    curr->pState = BLOCKED;
+    List_append(chanSendQueue, curr);
+    report("Channel %s is full: Process %d is now blocked. Waiting for room...\n", name, curr->PID);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Chan_receive(char* name) {
+    int chanID = Chan_find(name);
+    if(chanID == CHAN_FAIL) {
+        report("Error: Channel %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    if(!Chan_empty(chanID)) {
+        char text[CHAN_MAX_MSG];
+        int sender = Chan_pop(chanID, text, simTime);
+        report("Process %d sent a message on channel %s: %s\n", sender, name, text);
+        admit_chan_sender(chanID);  // A slot just freed up
+        return SCHED_SUCCESS;
+    }
+    if(curr == init) {
+        report("No messages: Cannot block init process. Returning to Main Menu...\n");
+        return SCHED_SUCCESS;
+    }
+    if(List_reserve(1) != LIST_SUCCESS) {
+        report("Error: Out of memory for the channel receive queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    curr->cold->chanID = chanID;
+    curr->pState = BLOCKED;
+    List_append(chanRecvQueue, curr);
+    report("No messages: Process %d is now blocked on channel %s. Waiting for message...\n", curr->PID, name);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Topic_create(char* name) {
+    if(Topic_open(name) == TOPIC_FAIL) {
+        report("Error: Cannot open topic %s (name taken or %d topics open). Returning to Main Menu...\n",
+            name, TOPIC_MAX_TOPICS);
+        return SCHED_FAIL;
+    }
+    report("Success: Topic %s opened\n", name);
+    return SCHED_SUCCESS;
+}
+
+int Topic_join(char* name, bool subscribe) {
+    int topicID = Topic_find(name);
+    if(topicID == TOPIC_FAIL) {
+        report("Error: Topic %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    if(subscribe) {
+        if(Topic_subscribe(topicID, curr->PID) == TOPIC_FAIL) {
+            report("Error: Process %d is already subscribed to topic %s. Returning to Main Menu...\n", curr->PID, name);
+            return SCHED_FAIL;
+        }
+        report("Success: Process %d subscribed to topic %s\n", curr->PID, name);
+    } else {
+        if(Topic_unsubscribe(topicID, curr->PID) == TOPIC_FAIL) {
+            report("Error: Process %d is not subscribed to topic %s. Returning to Main Menu...\n", curr->PID, name);
+            return SCHED_FAIL;
+        }
+        report("Success: Process %d unsubscribed from topic %s\n", curr->PID, name);
+    }
+    return SCHED_SUCCESS;
+}
+
+int Topic_send(char* name, char* msg) {
+    int topicID = Topic_find(name);
+    if(topicID == TOPIC_FAIL) {
+        report("Error: Topic %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    int reached = Topic_publish(topicID, curr->PID, msg);
+    if(reached == TOPIC_FAIL) {
+        report("Error: Out of memory for topic messages. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: Process %d published on topic %s to %d subscriber(s)\n", curr->PID, name, reached);
+    int woken = wake_topic_receivers(topicID);
+    if(woken > 0) {
+        report("Success: %d blocked receiver(s) unblocked\n", woken);
+        dispatch_if_idle();
+    }
+    return SCHED_SUCCESS;
+}
+
+int Topic_recv(char* name) {
+    int topicID = Topic_find(name);
+    if(topicID == TOPIC_FAIL) {
+        report("Error: Topic %s not found. Returning to Main Menu...\n", name);
+        return SCHED_FAIL;
+    }
+    if(!Topic_subscribed(topicID, curr->PID)) {
+        report("Error: Process %d is not subscribed to topic %s. Returning to Main Menu...\n", curr->PID, name);
+        return SCHED_FAIL;
+    }
+    char text[TOPIC_MAX_MSG];
+    int publisher;
+    if(Topic_receive(topicID, curr->PID, text, &publisher)) {
+        report("Process %d published on topic %s: %s\n", publisher, name, text);
+        return SCHED_SUCCESS;
+    }
+    if(curr == init) {
+        report("No publications: Cannot block init process. Returning to Main Menu...\n");
+        return SCHED_SUCCESS;
+    }
+    if(List_reserve(1) != LIST_SUCCESS) {
+        report("Error: Out of memory for the topic queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    curr->cold->topicID = topicID;
+    curr->pState = BLOCKED;
+    List_append(topicQueue, curr);
+    report("No publications: Process %d is now blocked on topic %s. Waiting for a publication...\n", curr->PID, name);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Sem_V_n(int semID, int count) {
+    if(semID < 0 || semID > 4) {
+        report("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(!sem[semID].active) {
+        report("Error: Semaphore %d does not exist. Returning to Main Menu...\n", semID);
+        return SCHED_FAIL;
+    }
+    if(count < 0) {
+        report("Error: Invalid number of V() operations. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int waiters = List_count(sem[semID].semQueue);
+    int wake;
+    if(count == 0) {    // Broadcast: every waiter gets a unit
+        wake = waiters;
+        count = waiters;
+    } else {    // Waiter i is woken by the V() that brings the value up to 0 or less
+        wake = sem[semID].value < 0 ? -sem[semID].value : 0;
+        if(wake > count)
+            wake = count;
+        if(wake > waiters)
+            wake = waiters;
+    }
+    sem[semID].value += count;
+    sem_hold(semID, curr, -count);
+
+    int woken = wake_sem_waiters(semID, wake);
+    report("Success: Process %d did %d V() operation(s) on Semaphore %d (value: %d). %d process(es) unblocked\n",
+        curr->PID, count, semID, sem[semID].value, woken);
+    dispatch_if_idle(); // One dispatch for the whole batch
+    return SCHED_SUCCESS;
+}
+
+int Wait() {
+    PCB* zombie = PCB_reap(curr);
+    if(zombie) {    // A child has already exited, reap it without blocking
+        report("Success: Process %d reaped child %d\n", curr->PID, zombie->PID);
+        release_process(zombie);
+        return SCHED_SUCCESS;
+    }
+    if(curr == init ? PCB_count() == 1 : curr->cold->firstChild == NULL) {  // Every other process is a child of init
+        report("Error: Process %d has no children to wait for. Returning to Main Menu...\n", curr->PID);
+        return SCHED_FAIL;
+    }
+    if(curr == init) {
+        report("No exited children: Cannot block init process. Returning to Main Menu...\n");
+        return SCHED_SUCCESS;
+    }
+    if(List_append(waitQueue, curr) != LIST_SUCCESS) {
+        report("Error: Out of memory for the wait queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    curr->pState = BLOCKED;
+    report("No exited children: Process %d is now blocked. Waiting for a child to exit...\n", curr->PID);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Access(int vpn, bool write) {
+    if(curr->cold->mm == NULL && (curr->cold->mm = Mem_space_create()) == NULL) {
+        report("Error: Failed to create address space. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(vpn < 0 || vpn > MEM_MAX_VPN) {  // Checked before a write copies anything
+        report("Error: Invalid page %d [Valid pages = 0 to %d]. Returning to Main Menu...\n", vpn, MEM_MAX_VPN);
+        return SCHED_FAIL;
+    }
+    Mem_space* space = write ? Mem_space_write(curr->cold->mm) : curr->cold->mm;
+    if(space == NULL) {
+        report("Error: Out of memory copying the shared address space. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    bool copied = space != curr->cold->mm;
+    curr->cold->mm = space;
+    int result = Mem_access(curr->cold->mm, vpn, simTime);
+    if(result == MEM_FAIL) {
+        report("Error: Out of memory for the page tables. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    } else if(result == MEM_HIT && !copied) {
+        report("Success: Process %d %s page %d (hit)\n", curr->PID, write ? "wrote" : "read", vpn);
+        return SCHED_SUCCESS;
+    }
+
+    if(copied)  // Taken like a page fault
+        report("Copy-on-write fault: Process %d wrote page %d of a shared address space, copied %d resident page(s)\n",
+            curr->PID, vpn, curr->cold->mm->resident);
+    else
+        report("Page fault: Process %d faulted on page %d (%d resident)\n", curr->PID, vpn, curr->cold->mm->resident);
+    if(curr == init) {
+        report("Cannot block init process\n");
+        return SCHED_SUCCESS;
+    } else if(Mem_latency() == 0)
+        return SCHED_SUCCESS;
+    if(List_reserve(1) != LIST_SUCCESS || !schedule(simTime + Mem_latency(), EV_FAULT_DONE, curr->PID, "the page fault")) {
+        report("Process %d carries on without waiting for the page\n", curr->PID);
+        return SCHED_SUCCESS;   // Nothing would wake it, the page is already resident
+    }
+    curr->pState = BLOCKED;
+    curr->cold->wakeTime = simTime + Mem_latency();
+    List_append(faultQueue, curr);
+    report("Process %d is now blocked until the page is loaded\n", curr->PID);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Configure_memory(int frames, int policy, int latency, long window) {
+    if(window < 1 || Mem_configure(frames, policy, latency) != 0 || Mem_set_window(window) != 0) {
+        report("Error: Invalid memory configuration. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: Memory configured\n");
+    if(reportsOn)
+        Mem_print_stats(simTime);
+    return SCHED_SUCCESS;
+}
+
+int Device_io(int deviceID, int sector) {
+    if(curr == init) {
+        report("Error: Cannot block init process on I/O. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(List_reserve(1) != LIST_SUCCESS) {   // The process is only blocked once it has a place on the I/O queue
+        report("Error: Out of memory for the I/O queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int result = Dev_submit(deviceID, curr, sector, simTime);
+    if(result == DEV_NO_DEVICE) {
+        report("Error: Device %d does not exist. Returning to Main Menu...\n", deviceID);
+        return SCHED_FAIL;
+    } else if(result != DEV_SUCCESS) {
+        report("Error: Out of memory for a request to device %d. Returning to Main Menu...\n", deviceID);
+        return SCHED_FAIL;
+    }
+    schedule_device();
+    curr->pState = BLOCKED;
+    List_append(ioQueue, curr);
+    report("Success: Process %d issued I/O to device %d and is now blocked\n", curr->PID, deviceID);
+    switch_process();
+    return SCHED_SUCCESS;
+}
+
+int Configure_device(int deviceID, int type, int discipline, int distribution, int meanService, int deadline) {
+    if(Dev_configure(deviceID, type, discipline, distribution, meanService, deadline) != DEV_SUCCESS) {
+        report("Error: Invalid device configuration or device is busy. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    report("Success: Device %d configured\n", deviceID);
+    return SCHED_SUCCESS;
+}
+
+int Configure_sem_order(int semID, int order) {
+    if(semID < 0 || semID > 4) {
+        report("Error: Invalid semaphore ID [Valid ID = 0 to 4]. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(order < WAITQ_FIFO || order > WAITQ_DEADLINE) {
+        report("Error: Invalid wait order. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    if(List_count(sem[semID].semQueue) > 0) {
+        report("Error: Processes are blocked on Semaphore %d. Returning to Main Menu...\n", semID);
+        return SCHED_FAIL;
+    }
+    sem[semID].order = order;
+    const char* names[] = {"FIFO", "priority", "deadline"};
+    report("Success: Semaphore %d wakes blocked processes in %s order\n", semID, names[order]);
+    return SCHED_SUCCESS;
+}
+
+int Kill_group(int groupID) {
+    if(groupID == 0) {  // Cannot kill init process
+        report("Error: Cannot terminate the init process group. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int killed = sweep_all(groupID, GROUP_KILL, -1);
+    bool killCurr = curr != init && PCB_group(curr) == groupID;
+    if(killed == 0 && !killCurr) {
+        report("Error: Process group %d not found\n", groupID);
+        return SCHED_FAIL;
+    }
+    report("Success: Terminated %d process(es) in group %d\n", killed + killCurr, groupID);
+    // Terminate only after the sweep so that waking parents cannot disturb a queue being walked
+    PCB* batch[64];
+    int n;
+    while((n = List_drain(killQueue, (void**)batch, 64)) > 0) {
+        for(int i = 0; i < n; i++)
+            terminate_process(batch[i]);
+    }
+    if(killCurr) {  // Running process was part of the group
+        account_cpu();
+        terminate_process(curr);
+        curr = NULL;
+        switch_process();
+    }
+    return SCHED_SUCCESS;
+}
+
+int Suspend_group(int groupID) {
+    if(groupID == 0) {
+        report("Error: Cannot suspend the init process group. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    bool suspendCurr = curr != init && PCB_group(curr) == groupID;
+    if(suspendCurr && List_reserve(1) != LIST_SUCCESS) {    // The running process goes to the suspend queue
+        report("Error: Out of memory for the suspend queue. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int suspended = sweep_all(groupID, GROUP_SUSPEND, -1);
+    if(suspended == 0 && !suspendCurr) {
+        report("Error: Process group %d not found\n", groupID);
+        return SCHED_FAIL;
+    }
+    report("Success: Suspended %d process(es) in group %d\n", suspended + suspendCurr, groupID);
+    if(suspendCurr) {   // Running process was part of the group
+        curr->suspended = true;
+        make_ready(curr);
+        switch_process();
+    }
+    return SCHED_SUCCESS;
+}
+
+int Resume_group(int groupID) {
+    int resumed = sweep_all(groupID, GROUP_RESUME, -1);
+    if(resumed == 0) {
+        report("Error: Process group %d has no suspended processes\n", groupID);
+        return SCHED_FAIL;
+    }
+    report("Success: Resumed %d process(es) in group %d\n", resumed, groupID);
+    dispatch_if_idle(); // Give the CPU to a resumed process if nothing was running or it outranks the running one
+    return SCHED_SUCCESS;
+}
+
+int Priority_group(int groupID, int priority) {
+    if(groupID == 0) {
+        report("Error: Cannot change priority of the init process group. Returning to Main Menu...\n");
+        return SCHED_FAIL;
+    }
+    int changed = sweep_all(groupID, GROUP_PRIORITY, priority);
+    if(curr != init && PCB_group(curr) == groupID && curr->priority != priority && curr->policy == POLICY_NORMAL) {
+        curr->priority = priority;
+        curr->boostedFrom = -1;
+        changed++;
+    }
+    if(changed == 0) {
+        report("Error: Process group %d not found or already at priority %d\n", groupID, priority);
+        return SCHED_FAIL;
+    }
+    report("Success: Set priority %d on %d process(es) in group %d\n", priority, changed, groupID);
+    check_preempt();
+    return SCHED_SUCCESS;
+}
+
+int Procinfo(int pid) {
+    if(pid == 0) {  // Display info for init process
+        report("Process ID: %d\n", init->PID);
+        report("Priority: %d\n", init->priority);
+        report("State: %d\n", init->pState);
+        report("Sender PID: %d\n", init->cold->senderPID);
+        report("Receive Message: %s\n", init->cold->msgs->recv_msg);
+        report("Send Message: %s\n", init->cold->msgs->send_msg);
+        return SCHED_SUCCESS;
+    }
+    PCB* process = NULL;
+    List* searchQueue = NULL;
+    if(curr->PID == pid) {  // If current process is the one being searched for
+        report("Running: Process %d\n", curr->PID);
+        process = curr;
+    } else {    // If process is in a queue
+        searchQueue = search_process(pid);
+        if(searchQueue) {
+            process = List_curr(searchQueue);
+            report("Process %d is not running\n", pid);
+        } else {
+            report("Error: Process %d does not exist. Returning to Main Menu...\n", pid);
+            return SCHED_FAIL;
+        }
+    }
+
+    report("Process ID: %d\n", process->PID);
+    report("Priority: %d\n", process->priority);
+    if(process->boostedFrom >= 0)
+        report("\tBoosted from priority %d until its next quantum expires\n", process->boostedFrom);
+    if(process->policy == POLICY_FIFO || process->policy == POLICY_RR)
+        report("Real-time: %s, priority %d\n", process->policy == POLICY_FIFO ? "FIFO" : "RR", process->rtPriority);
+    else if(process->policy == POLICY_DEADLINE) {
+        report("Deadline: runtime %ld, deadline %ld, period %ld, %d deadline miss(es)\n",
+            process->cold->dl->runtime, process->cold->dl->deadline, process->cold->dl->period, process->cold->dl->misses);
+        report("\t%ld tick(s) of runtime left before time %ld\n", process->cold->dl->budget, process->cold->dl->absDeadline);
+        if(searchQueue == throttleQueue)
+            report("\tProcess is throttled until its next period\n");
+    } else if(searchQueue == throttleQueue)
+        report("\tProcess is held back until cgroup %s is refilled\n", Cg_name(process->cgroup));
+    if(process->cgroup != CG_ROOT)
+        report("Cgroup: %s\n", Cg_name(process->cgroup));
+    report("Sender PID: %d\n", process->cold->senderPID);
+    report("Receive Message: %s\n", process->cold->msgs->recv_msg);
+    report("Send Message: %s\n", process->cold->msgs->send_msg);
+    int privateBytes;
+    int totalBytes = PCB_memory(process, &privateBytes);
+    if(process->cold->msgs->refCount == 0 && totalBytes == privateBytes)
+        report("Memory: %d bytes (no message buffers yet)\n", totalBytes);
+    else if(totalBytes == privateBytes)
+        report("Memory: %d bytes (all private)\n", totalBytes);
+    else if(process->cold->mm == NULL || process->cold->mm->refCount == 1)
+        report("Memory: %d bytes (%d private, message buffers shared by %d process(es))\n",
+            totalBytes, privateBytes, process->cold->msgs->refCount);
+    else
+        report("Memory: %d bytes (%d private, address space shared copy-on-write by %d process(es))\n",
+            totalBytes, privateBytes, process->cold->mm->refCount);
+    long cpu = process->cold->cpuTime + (process == curr && simTime > runStart ? simTime - runStart : 0);
+    report("CPU time: %ld ticks (%.1f%% of busy time), longest ready wait: %ld ticks\n", cpu,
+        busyTime > 0 ? 100.0 * cpu / busyTime : 0.0, process->cold->maxWait);
+    if(process->pState == READY && process->readySince >= 0)
+        report("\tProcess has been ready for %ld ticks\n", simTime - process->readySince);
+    if(process->cold->burst)
+        report("Workload: %ld ticks left in the current CPU burst\n", process->cold->burstLeft);
+    if(process->cold->mm)
+        report("Pages: %d resident, %d in the working set, %d faults, %d bytes of page tables%s\n",
+            process->cold->mm->resident, Mem_working_set(process->cold->mm, simTime), process->cold->mm->faults,
+            process->cold->mm->tableBytes, process->cold->mm->refCount > 1 ? " (shared)" : "");
+    report("Group ID: %d\n", PCB_group(process));
+    // Children of init are not linked to it
+    report("Parent PID: %d\n", process->cold->parent ? process->cold->parent->PID : (process == init ? -1 : init->PID));
+    report("State: %d\n", process->pState);
+    if(process->suspended)
+        report("\tProcess group is suspended\n");
+    if(process->cold->sync && Wfg_deadlocked(&process->cold->sync->wait))
+        report("\tProcess is deadlocked\n");
+    if(process->pState == BLOCKED) {
+        if(searchQueue == sendQueue)
+            report("\tProcess is blocked on send, waiting for reply\n");
+        else if(searchQueue == recvQueue)
+            report("\tProcess is blocked on receive, waiting for message\n");
+        else if(searchQueue == waitQueue)
+            report("\tProcess is blocked on wait, waiting for a child to exit\n");
+        else if(searchQueue == ioQueue)
+            report("\tProcess is blocked on I/O, waiting for the device to complete\n");
+        else if(searchQueue == faultQueue)
+            report("\tProcess is blocked on a page fault until time %ld\n", process->cold->wakeTime);
+        else if(searchQueue == chanSendQueue)
+            report("\tProcess is blocked sending on full channel %s\n", Chan_name(process->cold->chanID));
+        else if(searchQueue == chanRecvQueue)
+            report("\tProcess is blocked receiving on empty channel %s\n", Chan_name(process->cold->chanID));
+        else if(searchQueue == topicQueue)
+            report("\tProcess is blocked waiting for a publication on topic %s\n", Topic_name(process->cold->topicID));
+        else if(searchQueue == sleepQueue && process->cold->wakeTime < 0)
+            report("\tProcess is blocked until the trace wakes it\n");
+        else if(searchQueue == sleepQueue)
+            report("\tProcess is blocked in an I/O burst until time %ld\n", process->cold->wakeTime);
+        else if (searchQueue == sem[0].semQueue)
+            report("\tProcess is blocked on semaphore 1\n");
+        else if (searchQueue == sem[1].semQueue)
+            report("\tProcess is blocked on semaphore 2\n");
+        else if (searchQueue == sem[2].semQueue)
+            report("\tProcess is blocked on semaphore 3\n");
+        else if (searchQueue == sem[3].semQueue)
+            report("\tProcess is blocked on semaphore 4\n");
+        else if (searchQueue == sem[4].semQueue)
+            report("\tProcess is blocked on semaphore 5\n");
+        else 
+            report("\t Error: Process is blocked but not on a queue");
+    }
+    return SCHED_SUCCESS;
+}
+
+int Totalinfo() {
+    if(!reportsOn)  // The device, memory, channel and topic statistics print directly
+        return SCHED_SUCCESS;
+    report("Displaying all process queues and their info...\n\n");
+    report("Deadline Queue: ");
+    print_queue(dlQueue);
+    report("Real-time Queue: ");
+    print_queue(rtQueue);
+    report("High Priority Queue: ");
+    print_queue(highQueue);
+    report("Medium Priority Queue: ");
+    print_queue(medQueue);
+    report("Low Priority Queue: ");
+    print_queue(lowQueue);
+    report("\nReceive Queue: ");
+    print_queue(recvQueue);
+    report("Send Queue: ");
+    print_queue(sendQueue);
+    report("Wait Queue: ");
+    print_queue(waitQueue);
+    report("Page Fault Queue: ");
+    print_queue(faultQueue);
+    report("Sleep Queue: ");
+    print_queue(sleepQueue);
+    report("Channel Send Queue: ");
+    print_queue(chanSendQueue);
+    report("Channel Receive Queue: ");
+    print_queue(chanRecvQueue);
+    report("Topic Queue: ");
+    print_queue(topicQueue);
+    report("I/O Queue: ");
+    print_queue(ioQueue);
+    report("Suspend Queue: ");
+    print_queue(suspendQueue);
+    report("Throttled Queue: ");
+    print_queue(throttleQueue);
+    report("\n");
+    for(int i = 0; i < 5; i++)
+        print_sem_queue(i);
+    report("\n");
+    Mem_print_stats(simTime);
+    Dev_print_stats();
+    Chan_print_stats(simTime);
+    Topic_print_stats();
+    print_fairness();
+    Cg_print_stats();
+    PCB_print_stats();
+    report("Time: %ld, quantum lengths %ld/%ld/%ld, %d event(s) pending\n", simTime,
+        quantumLength[LOW], quantumLength[MED], quantumLength[HIGH], Event_count());
+    if(simTime > 0)
+        report("CPU utilisation: %.1f%%, throughput: %.4f jobs/tick (%d completed)\n",
+            100.0 * busyTime / simTime, (double)completedJobs / simTime, completedJobs);
+    if(simTime > 0 && switchCount > 0)
+        report("Context switches: %d, %ld tick(s) switching (%.1f%% of time)\n", switchCount, switchTime,
+            100.0 * switchTime / simTime);
+    if(preemptions > 0)
+        report("Preemptions: %d\n", preemptions);
+    if(dlCount > 0 || dlMisses > 0)
+        report("Deadline: %d process(es) reserving %.1f%% of %.0f%%, %d deadline miss(es)\n", dlCount,
+            100 * dlBandwidth, 100 * DL_MAX_BANDWIDTH, dlMisses);
+    if(reportsOn)
+        Energy_print_stats(simTime, completedJobs);
+    return SCHED_SUCCESS;
+}
+
+// -------------------------------------- Helper Functions --------------------------------------
+
+// Function to compare integers, used by search_process().
+bool compare_int(void* pItem, void* pComp){
+    if (((PCB*)pItem)->PID == *((int*)(pComp))){
+        return true;
+    }
+    return false;
+}
+
+// Matches processes of the group pointed to by pComp
+bool compare_group(void* pItem, void* pComp) {
+    return PCB_group(pItem) == *((int*)pComp);
+}
+
+// Returns the priority level of a ready queue
+int queue_priority(List* queue) {
+    if(queue == highQueue)
+        return HIGH;
+    if(queue == medQueue)
+        return MED;
+    if(queue == lowQueue)
+        return LOW;
+    return -1;
+}
+
+// Search all queues for the process with the given pid
+List* search_process(int pid) {
+    List* returnQueue = NULL;
+    if (curr->PID == pid){
+        report("Current process is the target of search\n");
+        return NULL;
+    }
+
+    COMPARATOR_FN compare = &compare_int;
+    List_first(highQueue);
+    if(List_search(highQueue, compare, &pid)) { // Search high priority queue
+        // printf("Target process is in the high priority queue\n");
+        returnQueue = highQueue;
+    }
+
+    List_first(medQueue);
+    if(List_search(medQueue, compare, &pid)) {  // Search medium priority queue
+        // printf("Target process is in the medium priority queue\n");
+        returnQueue = medQueue;
+    }
+
+    List_first(lowQueue);
+    if(List_search(lowQueue, compare, &pid)) {  // Search low priority queue
+        // printf("Target process is in the low priority queue\n");
+        returnQueue = lowQueue;
+    }
+
+    List_first(recvQueue);
+    if(List_search(recvQueue, compare, &pid)) { // Search receive queue
+        // printf("Target process is in the receive queue\n");
+        returnQueue = recvQueue;
+    }
+
+    List_first(sendQueue);
+    if(List_search(sendQueue, compare, &pid)) { // Search send queue
+        // printf("Target process is in the send queue\n");
+        returnQueue = sendQueue;
+    }
+
+    List_first(suspendQueue);
+    if(List_search(suspendQueue, compare, &pid)) {  // Search suspend queue
+        returnQueue = suspendQueue;
+    }
+
+    List_first(waitQueue);
+    if(List_search(waitQueue, compare, &pid)) { // Search wait queue
+        returnQueue = waitQueue;
+    }
+
+    List_first(faultQueue);
+    if(List_search(faultQueue, compare, &pid)) {    // Search page fault queue
+        returnQueue = faultQueue;
+    }
+
+    List_first(ioQueue);
+    if(List_search(ioQueue, compare, &pid)) {   // Search I/O queue
+        returnQueue = ioQueue;
+    }
+
+    List_first(sleepQueue);
+    if(List_search(sleepQueue, compare, &pid)) {    // Search sleep queue
+        returnQueue = sleepQueue;
+    }
+
+    List_first(chanSendQueue);
+    if(List_search(chanSendQueue, compare, &pid)) { // Search channel queues
+        returnQueue = chanSendQueue;
+    }
+
+    List_first(chanRecvQueue);
+    if(List_search(chanRecvQueue, compare, &pid)) {
+        returnQueue = chanRecvQueue;
+    }
+
+    List_first(topicQueue);
+    if(List_search(topicQueue, compare, &pid)) {    // Search topic queue
+        returnQueue = topicQueue;
+    }
+
+    List_first(dlQueue);
+    if(List_search(dlQueue, compare, &pid)) {   // Search real-time classes
+        returnQueue = dlQueue;
+    }
+
+    List_first(rtQueue);
+    if(List_search(rtQueue, compare, &pid)) {
+        returnQueue = rtQueue;
+    }
+
+    List_first(throttleQueue);
+    if(List_search(throttleQueue, compare, &pid)) { // Search throttled deadline processes
+        returnQueue = throttleQueue;
+    }
+
+    for(int i = 0; i < 5; i++) {    // Search all semaphore queues
+        List_first(sem[i].semQueue);
+        if(List_search(sem[i].semQueue, compare, &pid)) {
+            // printf("Target process is in the semaphore %d queue\n", i);
+            returnQueue = sem[i].semQueue;
+        }
+    }
+
+    return returnQueue;
+}
+
+// Function to switch to the next process in the ready queue or init if no processes in ready queue
+void switch_process() {
+    report("Switching to next process...\n");
+    if(curr && curr->pState == BLOCKED)
+        notify(SCHED_BLOCK, curr->PID);
+    account_cpu();  // Charge the outgoing process for the time it ran
+    // Place current process in temp and set to ready
+    // if(curr != init) {
+    //     PCB* temp = curr;
+    //     temp->pState = READY;
+    //     // Add current process to appropriate queue
+    //     if(temp->priority == 0) {
+    //         List_append(highQueue, temp);
+    //     } else if(temp->priority == 1) {
+    //         List_append(medQueue, temp);
+    //     } else if(temp->priority == 2) {
+    //         List_append(lowQueue, temp);
+    //     }
+    // }
+
+    // Set current process to next process in ready queue based on priority
+    // Deadline and real-time processes come first, their queues are kept in order
+    // Processes of throttled cgroups are held back as they come up
+    pick_next();
+    while(curr != init && curr->policy != POLICY_DEADLINE && Cg_throttled(curr->cgroup)) {
+        hold_back(curr);
+        pick_next();
+    }
+    // Print process message
+    if(curr->PID == 0)    // Case: Init process
+        report("Running: Init process\n");
+    // else if (*curr->send_msg != '\0') { // Case: Process has a message to send, print message and clear message
+    //     printf("Running: Process %d contains a message to send\n", curr->PID);
+    //     printf("%s\n", curr->send_msg);
+    //     *curr->send_msg = '\0';
+    // } 
+    else  // Case: Process has no message to send
+        report("Running: Process %d\n", curr->PID);
+    start_quantum();
+}
+
+// Takes the next process off the ready queues and makes it the running process
+// The running process always owns its cold part, one that cannot get it stays queued and init runs instead
+void pick_next() {
+    PCB* next = peek_ready();
+    if(next != NULL && PCB_write_cold(next) == NULL) {
+        report("Error: Out of memory for the state of process %d, it cannot run yet\n", next->PID);
+        next = NULL;
+    }
+    if(next != NULL)
+        take_from(next, next->queue);
+    curr = next != NULL ? next : init;
+    curr->pState = RUNNING;
+}
+
+// Places a process on the ready queue for its priority, or the suspend queue if its group is suspended
+int make_ready(PCB* process) {
+    process->pState = READY;
+    process->readySince = process->suspended ? -1 : simTime;  // Suspended processes cannot run
+    notify(SCHED_READY, process->PID);
+    if(process->policy == POLICY_DEADLINE && process != curr)
+        cbs_wakeup(process);
+    int result;
+    if(process->suspended)
+        result = List_append(suspendQueue, process);
+    else if(process->policy != POLICY_NORMAL)
+        result = enqueue_ordered(process, false);
+    else
+        result = List_append(ready_queue(process->priority), process);
+    if(result != LIST_SUCCESS) {
+        report("Error: Out of memory for the ready queues, process %d cannot be queued\n", process->PID);
+        return SCHED_FAIL;
+    }
+    return SCHED_SUCCESS;
+}
+
+// The running process holds no queue node, one is set aside before it leaves the CPU for a queue.
+// Reports and returns false if that fails, the process then keeps the CPU
+bool reserve_curr(const char* action) {
+    if(List_reserve(1) == LIST_SUCCESS)
+        return true;
+    report("Error: Out of memory for the queues, process %d keeps running instead of %s\n", curr->PID, action);
+    return false;
+}
+
+// Returns the ready queue for the given priority
+List* ready_queue(int priority) {
+    if(priority == HIGH)
+        return highQueue;
+    else if(priority == MED)
+        return medQueue;
+    return lowQueue;
+}
+
+// Walks the queue once and applies the group action to every member of the group
+int sweep_group(List* queue, int groupID, enum group_action action, int priority) {
+    if(action == GROUP_KILL)    // Relink every member onto the kill queue in one pass
+        return List_migrate(killQueue, queue, &compare_group, &groupID);
+    int count = 0;
+    PCB* process = List_first(queue);
+    while(process != NULL) {
+        if(PCB_group(process) != groupID || (action == GROUP_PRIORITY && process->policy != POLICY_NORMAL)) {
+            process = List_next(queue);     // Priority levels only apply to normal processes
+            continue;
+        }
+
+        bool take = false;  // Whether the process leaves this queue
+        if(action == GROUP_SUSPEND) {
+            if(!process->suspended)
+                count++;
+            process->suspended = true;
+            // Ready processes move to the suspend queue, blocked ones are suspended once unblocked
+            take = process->pState == READY && queue != suspendQueue;
+        } else if(action == GROUP_RESUME) {
+            if(process->suspended)
+                count++;
+            process->suspended = false;
+            take = queue == suspendQueue;
+        } else if(action == GROUP_PRIORITY) {
+            if(process->priority != priority)   // Moved processes are seen again in their new queue
+                count++;
+            process->priority = priority;
+            process->boostedFrom = -1;  // An explicit priority replaces the boost
+            take = process->pState == READY && !process->suspended && queue != ready_queue(priority);
+        }
+
+        if(take) {
+            List_remove(queue); // Next item becomes the current one
+            make_ready(process);
+            process = List_curr(queue);
+        } else
+            process = List_next(queue);
+    }
+    return count;
+}
+
+// Applies the group action to every queue in the system
+int sweep_all(int groupID, enum group_action action, int priority) {
+    int count = 0;
+    count += sweep_group(highQueue, groupID, action, priority);
+    count += sweep_group(medQueue, groupID, action, priority);
+    count += sweep_group(lowQueue, groupID, action, priority);
+    count += sweep_group(recvQueue, groupID, action, priority);
+    count += sweep_group(sendQueue, groupID, action, priority);
+    count += sweep_group(suspendQueue, groupID, action, priority);
+    count += sweep_group(waitQueue, groupID, action, priority);
+    count += sweep_group(faultQueue, groupID, action, priority);
+    count += sweep_group(ioQueue, groupID, action, priority);
+    count += sweep_group(sleepQueue, groupID, action, priority);
+    count += sweep_group(chanSendQueue, groupID, action, priority);
+    count += sweep_group(chanRecvQueue, groupID, action, priority);
+    count += sweep_group(topicQueue, groupID, action, priority);
+    count += sweep_group(dlQueue, groupID, action, priority);
+    count += sweep_group(rtQueue, groupID, action, priority);
+    count += sweep_group(throttleQueue, groupID, action, priority);
+    for(int i = 0; i < 5; i++) {
+        sem_sweep_waiters(i, groupID, action, priority);
+        int n = sweep_group(sem[i].semQueue, groupID, action, priority);
+        if(action == GROUP_KILL && n > 0) { // Killed waiters give their semaphore count back
+            sem[i].value += n;
+            report("Semaphore %d now has value %d\n", i, sem[i].value);
+        }
+        count += n;
+    }
+    return count;
+}
+
+// Removes a process from the system, the process must already be off every queue
+void terminate_process(PCB* process) {
+    notify(SCHED_EXIT, process->PID);
+    Fair_leave(process->cold->cpuTime);
+    Cg_detach(process->cgroup);
+    if(process->policy == POLICY_DEADLINE) {    // Hand back the reservation
+        dlBandwidth -= (double)process->cold->dl->runtime /
+            (process->cold->dl->deadline < process->cold->dl->period ? process->cold->dl->deadline : process->cold->dl->period);
+        if(--dlCount == 0)
+            dlBandwidth = 0;    // Drop accumulated rounding error
+    }
+    // Exited children are reaped by init straight away, live ones are adopted by it and left unlinked
+    PCB* zombie;
+    while((zombie = PCB_reap(process)) != NULL)
+        release_process(zombie);
+    PCB_reparent(process, NULL);
+    if(process->cold->mm != NULL) {   // Frames go back to the pool even if the process stays a zombie
+        Mem_space_free(process->cold->mm);
+        process->cold->mm = NULL;
+    }
+    Dev_cancel(process);    // Outstanding I/O completes without waking anyone
+    release_waits(process);
+    Topic_drop_process(process->PID);  // Unread publications are released with its subscriptions
+
+    PCB* parent = process->cold->parent;
+    if(parent == NULL || parent == init) {  // init reaps its children immediately
+        release_process(process);
+        return;
+    }
+
+    PCB_make_zombie(process);
+    report("Process %d is a zombie until process %d reaps it\n", process->PID, parent->PID);
+    // Wake the parent if it is blocked in Wait(), the queue watch tells whether it is still there
+    if(parent->pState == BLOCKED && take_from(parent, SNAP_WAIT)) {
+        report("Success: Process %d reaped child %d, process unblocked\n", parent->PID, process->PID);
+        release_process(PCB_reap(parent));
+        make_ready(parent);
+    }
+}
+
+// Handles every pending event up to time until in time order and advances the clock to until
+int run_until(long until) {
+    int handled = 0;
+    Event ev;
+    while(sysRunning && Event_peek(&ev) && ev.time <= until) {
+        Event_pop(&ev);
+        simTime = ev.time;  // Jump straight to the next event
+        handle_event(&ev);
+        handled++;
+        dispatch_if_idle(); // The CPU is idle, hand it to anything the event made ready
+    }
+    if(simTime < until)
+        simTime = until;
+    return handled;
+}
+
+// Handles a single event at the current simulated time
+void handle_event(Event* ev) {
+    PCB* process;
+    switch(ev->type) {
+        case EV_ARRIVAL:
+            report("Time %ld: Process arrival\n", simTime);
+            create_process(ev->arg, arrivalBurst ? Burst_copy(arrivalBurst) : NULL);
+            break;
+
+        case EV_QUANTUM:    // Ignore expiry events of earlier dispatches
+            if(ev->arg == dispatchCount && curr != init)
+                expire_quantum();
+            break;
+
+        case EV_FAULT_DONE: // Process may have been killed while it waited
+            process = PCB_find(ev->arg);
+            if(process && take_from(process, SNAP_FAULT)) {
+                report("Time %ld: Process %d finished its page fault\n", simTime, process->PID);
+                make_ready(process);
+            }
+            break;
+
+        case EV_BURST_DONE: // Running process finished its CPU burst
+            if(curr != init && ev->arg == curr->cold->burstGen)
+                end_burst();
+            break;
+
+        case EV_SLEEP_DONE:
+            process = PCB_find(ev->arg);
+            if(process && take_from(process, SNAP_SLEEP)) {
+                report("Time %ld: Process %d finished its I/O burst\n", simTime, process->PID);
+                make_ready(process);
+            }
+            break;
+
+        case EV_BOOST:
+            if(ev->arg == boostEpoch) {
+                report("Time %ld: ", simTime);
+                Boost();
+                if(!schedule(simTime + boostPeriod, EV_BOOST, boostEpoch, "the next priority boost"))
+                    boostPeriod = 0;    // Periodic boosting has stopped
+            }
+            break;
+
+        case EV_IO_DONE:
+            Dev_advance(simTime);
+            collect_io();
+            schedule_device();
+            break;
+
+        case EV_REPLENISH:
+            replenish(ev->arg);
+            break;
+
+        case EV_DEADLINE:
+            check_deadline(ev->arg);
+            break;
+
+        case EV_PREEMPT:    // run_until() checks for preemption after every event
+            break;
+
+        case EV_CG_REFILL: {
+            long period = Cg_refill(ev->arg, simTime);
+            if(period > 0 && !schedule(simTime + period, EV_CG_REFILL, ev->arg, "the cgroup refill"))
+                Cg_cancel(ev->arg, simTime);    // Never refilled again, so no longer limited
+            if(period > 0) {    // Not replaced by a new limit
+                int released = release_throttled();
+                if(released > 0)
+                    report("Time %ld: Cgroup quota refilled, %d process(es) released\n", simTime, released);
+            }
+            break;
+        }
+    }
+}
+
+// Starts a new quantum for the running process, scheduling its expiry event
+void start_quantum() {
+    if(runStart > simTime) {    // Previous switch was cut short, the rest of it never happened
+        long unused = runStart - simTime;   // The switch comes after any wake-up latency
+        switchTime -= unused < lastSwitchCost ? unused : lastSwitchCost;
+        runStart = simTime;
+    }
+    dispatchCount++;
+    Event_cancel(&quantumTimer);    // Left pending, they would pile up while time stands still
+    Event_cancel(&burstTimer);
+    notify(SCHED_DISPATCH, curr->PID);
+    if(cgRunning != CG_FAIL)    // The running process is runnable in its cgroup, off the ready queues
+        Cg_runnable(cgRunning, -1);
+    cgRunning = curr != init ? curr->cgroup : CG_FAIL;
+    if(cgRunning != CG_FAIL)
+        Cg_runnable(cgRunning, 1);
+    check_waits(curr);
+    long recTime;
+    int recPid;
+    if(Replay_dispatch(simTime, curr->PID, &recTime, &recPid) != REPLAY_SUCCESS)
+        replay_diverged(false, recTime, recPid);
+    if(curr == init) {  // init runs until something else is ready, the CPU sleeps until the next event
+        Event next;
+        Energy_idle(simTime, Event_peek(&next) ? next.time - simTime : -1);
+        return;
+    }
+    long wake = Energy_wake(simTime);   // Exit latency of the C-state the CPU slept in
+    cpuSpeed = Energy_run(simTime, peek_ready() != NULL);
+    long cost = switch_cost(curr);
+    if(cost > 0) {
+        switchTime += cost;
+        switchCount++;
+    }
+    lastSwitchCost = cost;
+    lastPid = curr->PID;
+    runStart = simTime + wake + cost;   // The process only starts running once the CPU is awake and switched
+    dispatchTime = simTime;
+    long slice = cgroup_slice(curr, time_slice(curr));
+    quantumEnd = slice == LONG_MAX ? LONG_MAX : runStart + slice;
+    curr->cold->burstGen = ++burstStamps;    // Completions scheduled by earlier dispatches no longer count
+    if(curr->cold->burst && runStart + burst_ticks(curr) <= quantumEnd)  // Burst ends before the quantum expires
+        schedule_timer(&burstTimer, runStart + burst_ticks(curr), EV_BURST_DONE, curr->cold->burstGen, "the end of the CPU burst");
+    else if(quantumEnd != LONG_MAX)
+        schedule_timer(&quantumTimer, quantumEnd, EV_QUANTUM, dispatchCount, "the quantum expiry");
+}
+
+// Returns the ticks it takes to switch to process
+long switch_cost(PCB* process) {
+    if(process->PID == lastPid && process->cold->lastRan == simTime)  // Same process carries on, nothing to switch
+        return 0;
+    long cost = switchOverhead;
+    // Cache warm-up grows with the time other work has had to evict the process' lines
+    long away = process->cold->lastRan < 0 ? cacheDecay : simTime - process->cold->lastRan;
+    if(away >= cacheDecay)
+        cost += cacheRefill;
+    else
+        cost += cacheRefill * away / cacheDecay;
+    if(process->PID != lastPid) // Idling keeps the last address space loaded
+        cost += tlbFlush;
+    return cost;
+}
+
+// Returns the time slice of the running process
+long time_slice(PCB* process) {
+    if(process->policy == POLICY_FIFO)
+        return LONG_MAX;
+    if(process->policy == POLICY_RR)    // Real-time round robin uses the high priority quantum
+        return quantum_length(HIGH);
+    if(process->policy == POLICY_DEADLINE)  // Runs until its reservation is used up
+        return process->cold->dl->budget > 0 ? process->cold->dl->budget : 0;
+    return quantum_length(process->priority);
+}
+
+// Scales the slice to the process' share of its cgroup's round and cuts it short where the cgroup quota runs out
+long cgroup_slice(PCB* process, long slice) {
+    if(process->policy == POLICY_DEADLINE)
+        return slice;
+    slice = Cg_scale(process->cgroup, slice);
+    long left = Cg_runtime_left(process->cgroup);
+    return left < slice ? left : slice;
+}
+
+// Returns the ticks it takes process to finish its burst at the current CPU speed
+long burst_ticks(PCB* process) {
+    long work = process->cold->burstLeft * 100 - process->cold->burstCarry;
+    return work <= 0 ? 0 : (work + cpuSpeed - 1) / cpuSpeed;
+}
+
+// Returns the quantum length for the given priority level
+long quantum_length(int priority) {
+    if(priority < LOW || priority > HIGH)
+        return quantumLength[MED];
+    return quantumLength[priority];
+}
+
+// Charges the time since the running process was dispatched to it and to the CPU busy time
+// Nothing is charged while the switch to the process is still in progress
+void account_cpu() {
+    if(curr == NULL || curr == init) {
+        runStart = simTime;
+        return;
+    }
+    if(runStart > simTime)  // Still switching to the process
+        return;
+    curr->cold->lastRan = simTime;
+    long ran = simTime - runStart;
+    busyTime += ran;
+    Fair_charge(curr->cold->cpuTime, ran, fair_level(curr));
+    curr->cold->cpuTime += ran;
+    if(curr->policy == POLICY_DEADLINE)
+        curr->cold->dl->budget -= ran;
+    Cg_charge(curr->cgroup, ran, simTime);
+    if(curr->cold->burst) {   // Below full speed a tick does only part of a tick of work
+        long work = ran * cpuSpeed + curr->cold->burstCarry;
+        curr->cold->burstLeft -= work / 100;
+        curr->cold->burstCarry = work % 100;
+    }
+    runStart = simTime;
+}
+
+// The running process finished its CPU burst
+void end_burst() {
+    account_cpu();
+    long io, cpu;
+    if(!Burst_next(curr->cold->burst, &io, &cpu)) {   // Workload complete
+        report("Time %ld: Process %d completed its workload\n", simTime, curr->PID);
+        completedJobs++;
+        Exit();
+        return;
+    }
+    curr->cold->burstLeft = cpu;
+    curr->cold->burstCarry = 0;
+    if(!reserve_curr("blocking or yielding")) {   // The next CPU burst starts straight away
+        start_quantum();
+        return;
+    }
+    if(io == 0) {   // Voluntary yield
+        report("Time %ld: Process %d yielded the CPU\n", simTime, curr->PID);
+        make_ready(curr);
+        switch_process();
+    } else if(curr->cold->burst->device != BURST_NO_DEVICE &&
+        Dev_submit(curr->cold->burst->device, curr, (int)(Random_next() % 1024), simTime) == DEV_SUCCESS) {
+        report("Time %ld: Process %d blocked on I/O to device %d\n", simTime, curr->PID, curr->cold->burst->device);
+        schedule_device();
+        curr->pState = BLOCKED;
+        List_append(ioQueue, curr);
+        switch_process();
+    } else if(!schedule(simTime + io, EV_SLEEP_DONE, curr->PID, "the end of the I/O burst")) {
+        report("Time %ld: Process %d skipped its I/O burst\n", simTime, curr->PID);
+        make_ready(curr);   // Nothing would wake it, it yields instead
+        switch_process();
+    } else {    // Timed I/O burst
+        report("Time %ld: Process %d blocked in an I/O burst for %ld ticks\n", simTime, curr->PID, io);
+        curr->pState = BLOCKED;
+        curr->cold->wakeTime = simTime + io;
+        List_append(sleepQueue, curr);
+        switch_process();
+    }
+}
+
+// Attaches model to process and starts its first CPU burst, frees the model if that fails
+int attach_burst(PCB* process, Burst* model) {
+    if(PCB_write_cold(process) == NULL) {
+        report("Error: Out of memory for the state of process %d. Returning to Main Menu...\n", process->PID);
+        Burst_free(model);
+        return SCHED_FAIL;
+    }
+    if(process == curr)
+        account_cpu();
+    Burst_free(process->cold->burst);
+    process->cold->burst = model;
+    process->cold->burstLeft = Burst_first(model);
+    process->cold->burstCarry = 0;
+    process->cold->burstGen = ++burstStamps;  // The old model's completion event must not fire
+    // The running process may now finish its burst before its quantum expires
+    if(process == curr && runStart + burst_ticks(curr) <= quantumEnd)  // Past simTime while still switching
+        schedule_timer(&burstTimer, runStart + burst_ticks(curr), EV_BURST_DONE, curr->cold->burstGen, "the end of the CPU burst");
+    return SCHED_SUCCESS;
+}
+
+// Creates a process of a real-time class
+PCB* create_policy_process(int policy, int rtPriority, long runtime, long deadline, long period) {
+    // Reported with the highest level, it is not used for scheduling
+    PCB* process = List_reserve(1) == LIST_SUCCESS ? PCB_create(HIGH) : NULL;
+    if(process != NULL && policy == POLICY_DEADLINE && PCB_get_dl(process) == NULL) {
+        PCB_free(process);
+        process = NULL;
+    }
+    if(process == NULL) {
+        report("Error: Process creation failed. Returning to Main Menu...\n");
+        return NULL;
+    }
+    process->policy = policy;
+    if(policy == POLICY_DEADLINE) {
+        process->cold->dl->runtime = runtime;
+        process->cold->dl->deadline = deadline;
+        process->cold->dl->period = period;
+        dlBandwidth += (double)runtime / (deadline < period ? deadline : period);
+        dlCount++;
+        set_deadline(process, simTime + deadline);
+        report("Success: Deadline process %d created with %ld tick(s) every %ld before deadline %ld\n",
+            process->PID, runtime, period, deadline);
+    } else {
+        process->rtPriority = rtPriority;
+        report("Success: Real-time %s process %d created with priority %d\n",
+            policy == POLICY_FIFO ? "FIFO" : "RR", process->PID, rtPriority);
+    }
+    notify(SCHED_CREATE, process->PID);
+    Fair_join();
+    Cg_attach(process->cgroup);
+    if(start_process(process) != SCHED_SUCCESS) {
+        discard_process(process);
+        return NULL;
+    }
+    return process;
+}
+
+// Creates a process with the given priority and burst model
+PCB* create_process(int priority, Burst* model) {
+    // A queue node is set aside first, the new process can always be readied
+    PCB* process = List_reserve(1) == LIST_SUCCESS ? PCB_create(priority) : NULL;
+    if(process != NULL && model != NULL && PCB_write_cold(process) == NULL) {
+        PCB_free(process);
+        process = NULL;
+    }
+    if(process == NULL) {
+        report("Error: Process creation failed. Returning to Main Menu...\n");
+        Burst_free(model);
+        return NULL;
+    }
+    report("Success: Process %d created\n", process->PID);
+    notify(SCHED_CREATE, process->PID);
+    Fair_join();
+    Cg_attach(process->cgroup);   // Created processes belong to init, which does not link its children
+    if(model) {
+        process->cold->burst = model;
+        process->cold->burstLeft = Burst_first(model);
+    }
+    if(start_process(process) != SCHED_SUCCESS) {
+        discard_process(process);
+        return NULL;
+    }
+    return process;
+}
+
+// Runs the new process or readies it
+int start_process(PCB* process) {
+    // If init is running, make new process the current running process
+    if(curr->PID == 0 && PCB_write_cold(process) != NULL) {
+        init->pState = READY;
+        process->pState = RUNNING;
+        curr = process;
+        report("Process %d is running\n", process->PID);
+        start_quantum();
+        return SCHED_SUCCESS;
+    }
+    // Place current process in the appropriate ready queue, as well as one that cannot run for lack of memory
+    return make_ready(process);
+}
+
+// Takes back a new process that could not be queued
+void discard_process(PCB* process) {
+    report("Error: Process %d discarded. Returning to Main Menu...\n", process->PID);
+    PCB_remove_child(process);  // Without a parent it is freed straight away
+    terminate_process(process);
+}
+
+// Forks parent onto its ready queue
+PCB* fork_process(PCB* parent) {
+    // Message buffers are shared until either process writes to them
+    // The parent is linked to the child, so it needs a cold part of its own unless it is init
+    PCB* child = NULL;
+    if(List_reserve(1) == LIST_SUCCESS && (parent == init || PCB_write_cold(parent) != NULL))
+        child = PCB_fork(parent);   // Same priority as the parent
+    if(child == NULL)
+        return NULL;
+    child->cold->groupID = PCB_group(parent);   // Child joins the parent's process group
+    child->policy = parent->policy;     // Real-time children keep the parent's class
+    child->rtPriority = parent->rtPriority;
+    child->cgroup = parent->cgroup;
+    Cg_attach(child->cgroup);
+    notify(SCHED_CREATE, child->PID);
+    Fair_join();
+    if(parent != init)  // Children of init are not linked
+        PCB_add_child(parent, child);
+    if(make_ready(child) != SCHED_SUCCESS) {
+        discard_process(child);
+        return NULL;
+    }
+    return child;
+}
+
+// Hands the CPU to a ready process if init is running or is outranked by one
+void dispatch_if_idle() {
+    PCB* next = peek_ready();
+    if(next == NULL)
+        return;
+    if(curr == init)
+        switch_process();
+    else
+        check_preempt();
+}
+
+// Wakeups of normal processes respect the granularity, a check is scheduled for when it has passed
+void check_preempt() {
+    PCB* next = peek_ready();
+    if(curr == init || next == NULL || !outranks(next, curr))
+        return;
+    long allowed = dispatchTime + wakeupGranularity;
+    if(next->policy == POLICY_NORMAL && simTime < allowed) {
+        if(preemptArmed == dispatchCount)
+            return;
+        if(schedule(allowed, EV_PREEMPT, dispatchCount, "the deferred preemption")) {
+            preemptArmed = dispatchCount;
+            return;
+        }   // Otherwise preempt now rather than never
+    }
+    preempt_curr();
+}
+
+// Returns the next process to run
+PCB* peek_ready() {
+    if(List_count(dlQueue))
+        return List_first(dlQueue);
+    if(List_count(rtQueue))
+        return List_first(rtQueue);
+    if(List_count(highQueue))
+        return List_first(highQueue);
+    if(List_count(medQueue))
+        return List_first(medQueue);
+    return List_first(lowQueue);
+}
+
+// Deadline beats real-time beats normal, within a class the earlier deadline or higher real-time priority wins
+bool outranks(PCB* process, PCB* running) {
+    static const int rank[] = {0, 1, 1, 2};    // By policy
+    if(rank[process->policy] != rank[running->policy])
+        return rank[process->policy] > rank[running->policy];
+    if(process->policy == POLICY_DEADLINE)
+        return process->cold->dl->absDeadline < running->cold->dl->absDeadline;
+    if(process->policy != POLICY_NORMAL)
+        return process->rtPriority > running->rtPriority;
+    return preemptive && process->priority > running->priority; // Otherwise normal processes run out their quantum
+}
+
+// Preempts the running process
+void preempt_curr() {
+    if(!reserve_curr("being preempted"))
+        return;
+    PCB* next = peek_ready();
+    report("Time %ld: Process %d preempted by process %d\n", simTime, curr->PID, next->PID);
+    preemptions++;
+    account_cpu();
+    curr->pState = READY;
+    curr->readySince = simTime;
+    notify(SCHED_READY, curr->PID);
+    if(curr->policy != POLICY_NORMAL)
+        enqueue_ordered(curr, true);
+    else
+        List_prepend(ready_queue(curr->priority), curr);    // Keeps its place in the round robin
+    switch_process();
+}
+
+// Real-time queues are short, a linear walk keeps them sorted
+int enqueue_ordered(PCB* process, bool ahead) {
+    List* queue = process->policy == POLICY_DEADLINE ? dlQueue : rtQueue;
+    long key = process->policy == POLICY_DEADLINE ? process->cold->dl->absDeadline : -process->rtPriority;
+    PCB* item = List_first(queue);
+    while(item != NULL) {
+        long itemKey = item->policy == POLICY_DEADLINE ? item->cold->dl->absDeadline : -item->rtPriority;
+        if(itemKey > key || (ahead && itemKey == key))
+            break;
+        item = List_next(queue);
+    }
+    if(item != NULL)
+        return List_insert_before(queue, process);
+    return List_append(queue, process);
+}
+
+// Starts a reservation and schedules the check for a miss of its deadline
+void set_deadline(PCB* process, long absDeadline) {
+    process->cold->dl->absDeadline = absDeadline;
+    process->cold->dl->budget = process->cold->dl->runtime;
+    schedule(absDeadline, EV_DEADLINE, process->PID, "the deadline check");
+}
+
+// A process whose remaining runtime would exceed its bandwidth before the deadline starts a new reservation
+void cbs_wakeup(PCB* process) {
+    long left = process->cold->dl->absDeadline - simTime;
+    if(left <= 0 || process->cold->dl->budget * process->cold->dl->period > left * process->cold->dl->runtime)
+        set_deadline(process, simTime + process->cold->dl->deadline);
+}
+
+// Processes of throttled cgroups wait with throttled deadline processes.
+// The running process is parked on a node set aside by expire_quantum(), the others reuse the node they just left
+void hold_back(PCB* process) {
+    report("Process %d held back, cgroup %s is throttled\n", process->PID, Cg_name(process->cgroup));
+    process->pState = READY;
+    List_append(throttleQueue, process);
+}
+
+// Parks the running process
+void park_curr() {
+    report("Time %ld: Cgroup %s used its quota\n", simTime, Cg_name(curr->cgroup));
+    hold_back(curr);
+    switch_process();
+}
+
+// Releases held back processes
+int release_throttled() {
+    int count = 0;
+    PCB* process = List_first(throttleQueue);
+    while(process != NULL) {
+        if(process->policy == POLICY_DEADLINE || Cg_throttled(process->cgroup)) {
+            process = List_next(throttleQueue);
+            continue;
+        }
+        List_remove(throttleQueue); // Next item becomes the current one
+        make_ready(process);
+        count++;
+        process = List_curr(throttleQueue);
+    }
+    return count;
+}
+
+// Throttles the running deadline process
+void throttle_curr() {
+    long next = curr->cold->dl->absDeadline - curr->cold->dl->deadline + curr->cold->dl->period; // Start of its next period
+    if(next < simTime)
+        next = simTime;
+    report("Time %ld: Deadline process %d used its runtime, throttled until time %ld\n", simTime, curr->PID, next);
+    curr->pState = READY;   // Runnable, but kept off the ready queues
+    List_append(throttleQueue, curr);
+    if(!schedule(next, EV_REPLENISH, curr->PID, "the replenishment"))
+        replenish(curr->PID);   // Its next reservation starts now instead of never
+    switch_process();
+}
+
+// Checks for a deadline miss at the deadline of a reservation
+void check_deadline(int pid) {
+    PCB* process = find_process(pid);
+    if(process == NULL || process->policy != POLICY_DEADLINE || process->cold->dl->absDeadline != simTime)
+        return; // Gone, or the reservation has moved on
+    if(process->pState == BLOCKED || process->suspended || process->cold->dl->budget <= 0)
+        return; // Nothing left to run in time
+    if(process == curr)
+        account_cpu();
+    if(process->cold->dl->budget <= 0)
+        return; // Used up its runtime exactly at the deadline
+    dlMisses++;
+    process->cold->dl->misses++;
+    report("Time %ld: Deadline process %d missed its deadline with %ld tick(s) of runtime left\n",
+        simTime, pid, process->cold->dl->budget);
+    // The late work carries on in the next period's reservation
+    set_deadline(process, simTime + process->cold->dl->period);
+    if(process == curr && !reserve_curr("taking its new place in the deadline order"))
+        start_quantum();    // With a fresh slice
+    else if(process == curr) {   // Its slice and place in the deadline order have changed
+        curr->pState = READY;
+        curr->readySince = simTime;
+        enqueue_ordered(curr, true);
+        switch_process();
+    } else if(take_from(process, SNAP_DEADLINE))
+        enqueue_ordered(process, false);
+}
+
+// Replenishes a throttled process at the start of its next period
+void replenish(int pid) {
+    PCB* process = PCB_find(pid);
+    if(process == NULL || !take_from(process, SNAP_THROTTLE))
+        return; // Killed or suspended while throttled
+    set_deadline(process, simTime + process->cold->dl->deadline);
+    report("Time %ld: Deadline process %d replenished, next deadline at time %ld\n", simTime, pid, process->cold->dl->absDeadline);
+    make_ready(process);
+}
+
+// Finds a live process by PID (running or on any queue)
+PCB* find_process(int pid) {
+    PCB* process = PCB_find(pid);
+    return process && process->pState != ZOMBIE ? process : NULL;
+}
+
+// Schedules an event for the earliest time a busy device finishes its request
+void schedule_device() {
+    long finish;
+    if(Dev_next_finish(&finish))
+        schedule(finish, EV_IO_DONE, 0, "the I/O completion");
+}
+
+// Schedules an event, reporting what is lost if the event queue cannot grow. Returns whether it was scheduled
+bool schedule(long time, int type, int arg, const char* what) {
+    return schedule_timer(NULL, time, type, arg, what);
+}
+
+// Schedules an event tied to timer (NULL = none), replacing the event already tied to it
+bool schedule_timer(Event_timer* timer, long time, int type, int arg, const char* what) {
+    if(Event_push_timer(time, type, arg, timer) == EVENT_SUCCESS)
+        return true;
+    report("Error: Out of memory for the event queue, %s at time %ld is lost\n", what, time);
+    return false;
+}
+
+// Readies every process whose I/O request has completed
+int collect_io() {
+    int count = 0;
+    PCB* process;
+    while((process = Dev_next_completion()) != NULL) {  // Drain the device completion queue
+        if(take_from(process, SNAP_IO)) {
+            report("Time %ld: Process %d finished its I/O request\n", simTime, process->PID);
+            make_ready(process);
+            count++;
+        }
+    }
+    return count;
+}
+
+// Function to print the processes of a given queue, used by Totalinfo()
+void print_queue(List* queue) {
+    if(!queue) {    // Case: Queue does not exist
+        report("Error: queue does not exist\n");
+        return;
+    }
+
+    if(List_count(queue) == 0) {    // Case: Queue is empty
+        report("\n");
+        return;
+    }
+
+    PCB* proc = List_first(queue);
+    while (proc != NULL){   // Print all processes in queue
+        report("%d | ", proc->PID);
+        proc = List_next(queue);
+    }
+    report("\n");
+
+    free(proc);
+}
+
+// Free function for PCB, does nothing
+void free_item(void *pItem) {}
+
+// Keeps the queue of a process up to date, called by the watched queues on every add and removal
+void queue_changed(void* item, Node* node, void* arg, bool added) {
+    PCB* process = item;
+    int queue = (int)(intptr_t)arg;
+    int level = queue < SNAP_LISTS ? queue_priority(*snapLists[queue]) : -1;
+    if(level >= 0)
+        track_ready(process, level, added);
+    if(queue < SNAP_READY_LISTS)    // Ready processes share their cgroup's slice
+        Cg_runnable(process->cgroup, added ? 1 : -1);
+    if(added) {
+        process->queue = queue;
+        process->queueNode = node;
+    } else if(process->queue == queue) {
+        process->queue = PCB_NO_QUEUE;
+        process->queueNode = NULL;
+    } else    // Left a queue it was also in, its queue has not changed
+        return;
+    snap_changed(process);
+}
+
+bool take_from(PCB* process, int queue) {
+    if(process->queue != queue)
+        return false;
+    List* list = queue < SNAP_LISTS ? *snapLists[queue] : sem[queue - SNAP_LISTS].semQueue;
+    List_remove_node(list, process->queueNode);
+    return true;
+}
+
+// Keeps the waiters of a normal ready level ordered by how long they have been ready, whatever
+// order the queue itself is in after splices and preemptions. Only done while starvation alarms are on
+void track_ready(PCB* process, int level, bool added) {
+    Waitq* waiters = &readyWaiters[level];
+    Waitq_node* node = process->cold->readyWait;
+    if(node != NULL && node->pos != NULL && (added || node->pos == waiters)) {
+        Waitq_remove(node->pos, node);
+        node->pos = NULL;
+    }
+    if(!added || starveThreshold == 0)
+        return;
+    if(node == NULL && (node = PCB_get_ready_wait(process)) == NULL) {
+        if(!waitsIncomplete)
+            report("Error: Out of memory for the ready waits, process %d cannot raise a starvation alarm\n", process->PID);
+        waitsIncomplete = true;
+        return;
+    }
+    Waitq_push(waiters, node, process, process->readySince);
+    node->pos = waiters;
+}
+
+// Records that process may have changed queue since the last snapshot, once per snapshot
+void snap_changed(PCB* process) {
+    if(snapTime < 0 || process->snapChanged)
+        return;
+    if(snapCount == snapCapacity) {
+        int capacity = snapCapacity ? 2 * snapCapacity : 64;
+        Snap_change* grown = realloc(snapChanges, capacity * sizeof(Snap_change));
+        if(grown == NULL) {
+            if(!snapIncomplete)
+                report("Error: Out of memory for the snapshot changes, process %d is missing from the next diff\n", process->PID);
+            snapIncomplete = true;
+            return;
+        }
+        snapChanges = grown;
+        snapCapacity = capacity;
+    }
+    snapChanges[snapCount].pid = process->PID;
+    snapChanges[snapCount++].from = process->snapQueue;
+    process->snapChanged = true;
+}
+
+// Returns the live process with the given PID, init keeps PID 0 whatever it was created with
+PCB* snap_find(int pid) {
+    return pid == 0 ? init : PCB_find(pid);
+}
+
+// Frees process, remembering for the snapshot diff that it exited
+void release_process(PCB* process) {
+    if(process == NULL)
+        return;
+    if(process->snapQueue != PCB_NOT_SNAPPED)
+        snap_changed(process);
+    if(process == snapRunner)
+        snapRunner = NULL;
+    PCB_free(process);
+}
+
+// Returns the name of a queue ID for snapshots
+const char* snap_name(int queue) {
+    if(queue >= 0 && queue < SNAP_QUEUES)
+        return snapNames[queue];
+    if(queue == SNAP_RUNNING)
+        return "running";
+    if(queue == PCB_NOT_SNAPPED)
+        return "new";
+    if(queue == SNAP_EXITED)
+        return "exited";
+    return "none";
+}
+
+// Reports a replay that no longer matches its recording and exits with a failure status
+void replay_diverged(bool atInput, long recTime, int recPid) {
+    printf("\nError: Replay diverged at record %ld (dispatch %d, time %ld): ", Replay_position(), dispatchCount, simTime);
+    if(atInput)
+        printf("recording dispatched a process before this input\n");
+    else if(recPid < 0)
+        printf("recording read input here, run dispatched process %d\n", curr->PID);
+    else
+        printf("recording dispatched process %d at time %ld, run dispatched process %d\n", recPid, recTime, curr->PID);
+    Replay_close();
+    exit(EXIT_FAILURE);
+}
+
+// Applies one trace event to the simulation, pid 0 is the idle task and is left out
+void apply_trace_event(Trace* trace, Trace_event* ev) {
+    PCB* process;
+    switch(ev->type) {
+        case TRACE_SWITCH:
+            // The next task is runnable even if the trace started while it slept
+            if(ev->other > 0 && (process = trace_process(trace, ev->other, ev->otherPrio)))
+                trace_unblock(process);
+            if(ev->sleeping && ev->pid > 0 && (process = trace_process(trace, ev->pid, ev->prio)))
+                trace_block(process);
+            break;
+
+        case TRACE_WAKEUP:
+            if(ev->pid > 0 && (process = trace_process(trace, ev->pid, ev->prio)))
+                trace_unblock(process);
+            break;
+
+        case TRACE_FORK:
+            if(ev->other <= 0 || Trace_map_get(trace, ev->other) >= 0)
+                break;
+            PCB* parent = ev->pid > 0 ? trace_process(trace, ev->pid, -1) : NULL;
+            if(parent == NULL) {
+                trace_process(trace, ev->other, -1);
+                break;
+            }
+            if(parent == curr)
+                account_cpu();
+            process = fork_process(parent);
+            if(process && Trace_map_set(trace, ev->other, process->PID))
+                report("Fork: process %d created\n", process->PID);
+            break;
+
+        case TRACE_EXIT: {
+            int pid = Trace_map_get(trace, ev->pid);
+            if(pid < 0)
+                break;
+            Trace_map_remove(trace, ev->pid);
+            process = find_process(pid);
+            if(process == NULL)
+                break;
+            // Sched traces do not show wait(), so exits are reaped straight away by init
+            PCB_remove_child(process);
+            Kill(pid);
+            break;
+        }
+    }
+}
+
+// Returns the process standing in for trace pid, creating it on first sight
+PCB* trace_process(Trace* trace, int pid, int prio) {
+    int simPid = Trace_map_get(trace, pid);
+    if(simPid >= 0)
+        return find_process(simPid);    // O(1) through the PID index
+    // Kernel priorities: below 120 is real-time or negative nice, 120 is nice 0
+    int priority = prio < 0 || prio == 120 ? MED : (prio < 120 ? HIGH : LOW);
+    PCB* process = create_process(priority, NULL);
+    if(process && !Trace_map_set(trace, pid, process->PID))
+        report("Error: Out of memory mapping trace task %d\n", pid);
+    return process;
+}
+
+// Blocks a running or ready process until the trace wakes it
+void trace_block(PCB* process) {
+    if(process == curr) {
+        if(!reserve_curr("blocking"))
+            return;
+        curr->pState = BLOCKED;
+        curr->cold->wakeTime = -1;
+        List_append(sleepQueue, curr);
+        switch_process();
+        return;
+    }
+    int level = process->queue;
+    if(level >= 0 && level < SNAP_READY_LISTS && queue_priority(*snapLists[level]) >= 0 && PCB_write_cold(process) != NULL &&
+        take_from(process, level)) {
+        process->pState = BLOCKED;
+        notify(SCHED_BLOCK, process->PID);
+        process->cold->wakeTime = -1;
+        List_append(sleepQueue, process);
+    }
+}
+
+// Readies a process blocked by trace_block()
+void trace_unblock(PCB* process) {
+    if(process->pState == BLOCKED && take_from(process, SNAP_SLEEP))
+        make_ready(process);
+}
+
+// Points the semaphore's wait-for edge at its owner
+void update_sem_edge(int semID) {
+    semaphore* s = &sem[semID];
+    if(s->owner == NULL) {
+        Wfg_release(&s->wait);
+        return;
+    }
+    if(s->wait.waitsFor != &s->owner->cold->sync->wait && Wfg_wait(&s->wait, &s->owner->cold->sync->wait))
+        report_deadlock(&s->wait);
+}
+
+int sem_hold(int semID, PCB* process, int delta) {
+    semaphore* s = &sem[semID];
+    if(process->cold->sync == NULL)   // Has never held anything, callers give units only to processes with a blocking state
+        return 0;
+    int held = process->cold->sync->semHeld[semID];
+    if(delta < -held)
+        delta = -held;
+    if(held + delta > UINT16_MAX)
+        delta = UINT16_MAX - held;
+    if(held == 0 && delta > 0) {
+        s->holders++;
+        s->holderSum += process->PID;
+    } else if(held > 0 && held + delta == 0) {
+        s->holders--;
+        s->holderSum -= process->PID;
+    }
+    process->cold->sync->semHeld[semID] = held + delta;
+    s->owner = s->holders == 1 ? PCB_find(s->holderSum) : NULL;
+    update_sem_edge(semID);
+    return delta < 0 ? -delta : delta;
+}
+
+// Makes process wait for target in the wait-for graph
+void wait_for(PCB* process, Wfg_node* target) {
+    if(Wfg_wait(&process->cold->sync->wait, target))
+        report_deadlock(&process->cold->sync->wait);
+}
+
+// Removes every wait-for edge from and to a process that is being terminated
+void release_waits(PCB* process) {
+    if(process->cold->sync == NULL)   // Never waited on or held anything
+        return;
+    Wfg_release(&process->cold->sync->wait);
+    for(int i = 0; i < 5; i++) {
+        if(process->cold->sync->semHeld[i] > 0) // Its hold on the semaphore dies with it
+            sem_hold(i, process, -process->cold->sync->semHeld[i]);
+    }
+    // Senders keep waiting for a reply that will never come, but no longer on this process
+    Wfg_release_waiters(&process->cold->sync->wait);
+}
+
+// Prints the cycle of the wait-for graph that starts at node
+void report_deadlock(Wfg_node* node) {
+    report("Deadlock detected: ");
+    Wfg_node* n = node;
+    do {
+        Wfg_node* next = n->waitsFor;
+        const char* relation = "is held by";
+        if(n->kind == WFG_PROCESS)
+            relation = next->kind == WFG_PROCESS ? "waits for a reply from" : "waits on";
+        report("%s%s %d %s %s %d", n == node ? "" : ", ", n->kind == WFG_PROCESS ? "process" : "semaphore",
+            n->id, relation, next->kind == WFG_PROCESS ? "process" : "semaphore", next->id);
+        n = next;
+    } while(n != node);
+    report("\n");
+}
+
+// Readies up to count waiters in the semaphore's wait order
+int wake_sem_waiters(int semID, int count) {
+    int woken = 0;
+    PCB* process;
+    while(woken < count && (process = sem_dequeue(semID)) != NULL) {
+        Wfg_release(&process->cold->sync->wait);
+        sem_hold(semID, process, 1);    // The woken process now holds the semaphore
+        make_ready(process);
+        woken++;
+    }
+    return woken;
+}
+
+// Blocks process on the semaphore, keyed by its wait order
+int sem_enqueue(int semID, PCB* process, long deadline) {
+    long key = 0;   // Equal keys leave in arrival order
+    if(sem[semID].order == WAITQ_PRIORITY)
+        key = -process->priority;
+    else if(sem[semID].order == WAITQ_DEADLINE)
+        key = deadline > 0 ? simTime + deadline : LONG_MAX;
+    // The heap only learns of the waiter once it has a node in semQueue for sem_dequeue to remove
+    if(List_append(sem[semID].semQueue, process) != LIST_SUCCESS)
+        return SCHED_FAIL;
+    Waitq_push(&sem[semID].waiters, &process->cold->sync->semWait, process, key);
+    process->cold->sync->semWait.pos = List_curr_node(sem[semID].semQueue);
+    return SCHED_SUCCESS;
+}
+
+// Takes the next waiter in wait order off the semaphore
+PCB* sem_dequeue(int semID) {
+    Waitq_node* node = Waitq_pop(&sem[semID].waiters);
+    if(node == NULL)
+        return NULL;
+    return List_remove_node(sem[semID].semQueue, node->pos);
+}
+
+// Keeps the semaphore's wait order in step with a group sweep
+void sem_sweep_waiters(int semID, int groupID, enum group_action action, int priority) {
+    bool rekey = action == GROUP_PRIORITY && sem[semID].order == WAITQ_PRIORITY;
+    if(action != GROUP_KILL && !rekey)
+        return;
+    List* queue = sem[semID].semQueue;
+    for(PCB* process = List_first(queue); process; process = List_next(queue)) {
+        if(PCB_group(process) != groupID)
+            continue;
+        Waitq_remove(&sem[semID].waiters, &process->cold->sync->semWait);
+        if(rekey)   // The node keeps its place in semQueue
+            Waitq_push(&sem[semID].waiters, &process->cold->sync->semWait, process, -priority);
+    }
+}
+
+// Prints the semaphore's queue in arrival order and the process it wakes next
+void print_sem_queue(int semID) {
+    report("Semaphore %d Queue: ", semID);
+    print_queue(sem[semID].semQueue);
+    Waitq_node* next = Waitq_peek(&sem[semID].waiters);
+    if(sem[semID].order != WAITQ_FIFO && next)
+        report("\t%s order, wakes process %d next\n", sem[semID].order == WAITQ_PRIORITY ? "Priority" : "Deadline",
+            ((PCB*)next->item)->PID);
+}
+
+// Moves the first sender blocked on the full channel into its buffer and readies it
+void admit_chan_sender(int chanID) {
+    COMPARATOR_FN compare = &compare_chan;
+    List_first(chanSendQueue);
+    PCB* sender = List_search(chanSendQueue, compare, &chanID);
+    if(sender == NULL)
+        return;
+    List_remove(chanSendQueue);
+    Chan_push(chanID, sender->PID, sender->cold->msgs->send_msg, simTime);
+    sender->cold->chanID = -1;
+    report("Success: Process %d's message entered channel %s, process unblocked\n", sender->PID, Chan_name(chanID));
+    make_ready(sender);
+    dispatch_if_idle();
+}
+
+// Matches processes blocked on the channel pointed to by pComp
+bool compare_chan(void* pItem, void* pComp) {
+    return ((PCB*)pItem)->cold->chanID == *((int*)pComp);
+}
+
+// Readies every receiver blocked on the topic, each takes its next publication
+int wake_topic_receivers(int topicID) {
+    // One pass over the topic queue collects the receivers, they are then readied in batches
+    int woken = List_migrate(topicWakeQueue, topicQueue, &compare_topic, &topicID);
+    PCB* batch[64];
+    int n;
+    while((n = List_drain(topicWakeQueue, (void**)batch, 64)) > 0) {
+        for(int i = 0; i < n; i++) {
+            PCB* receiver = batch[i];
+            PCB_msgs* msgs = PCB_write_msgs(receiver);
+            if(msgs == NULL && List_append(topicQueue, receiver) == LIST_SUCCESS) {
+                woken--;    // The publication is left for it, it keeps waiting
+                report("Error: Out of memory for message buffers, process %d stays blocked on topic %s\n",
+                    receiver->PID, Topic_name(topicID));
+                continue;
+            }
+            receiver->cold->topicID = -1;
+            if(msgs == NULL)
+                report("Error: Out of memory for message buffers, process %d unblocked without a publication\n",
+                    receiver->PID);
+            else if(Topic_receive(topicID, receiver->PID, msgs->recv_msg, &receiver->cold->senderPID))
+                report("Process %d received the publication on topic %s\n", receiver->PID, Topic_name(topicID));
+            make_ready(receiver);
+        }
+    }
+    return woken;
+}
+
+// Matches processes blocked on the topic pointed to by pComp
+bool compare_topic(void* pItem, void* pComp) {
+    return ((PCB*)pItem)->cold->topicID == *((int*)pComp);
+}
+
+// Passes a scheduling event to the event callback
+void notify(enum sched_event event, int pid) {
+    if(eventFn)
+        eventFn(event, pid, simTime, eventContext);
+}
+
+// Records the dispatched process' wait and raises starvation alarms
+void check_waits(PCB* process) {
+    if(process != init && process->readySince >= 0) {
+        long waited = simTime - process->readySince;
+        Fair_wait(waited, fair_level(process));
+        if(waited > process->cold->maxWait)
+            process->cold->maxWait = waited;
+        process->readySince = -1;
+        process->starving = false;
+    }
+    if(starveThreshold == 0)
+        return;
+    for(int level = HIGH; level >= LOW; level--) {
+        Waitq_node* node = Waitq_peek(&readyWaiters[level]);
+        PCB* waiter = node ? node->item : NULL;
+        if(waiter == NULL || waiter->starving || simTime - waiter->readySince < starveThreshold)
+            continue;
+        waiter->starving = true;
+        Fair_starved();
+        report("Starvation: Process %d has been ready for %ld ticks at priority %d\n", waiter->PID,
+            simTime - waiter->readySince, level);
+        notify(SCHED_STARVE, waiter->PID);
+    }
+}
+
+// Returns the fairness level a process is counted at, deadline and real-time processes have their own
+int fair_level(PCB* process) {
+    return process->policy == POLICY_NORMAL ? process->priority : FAIR_REALTIME;
+}
+
+// Prints the fairness statistics, including how long the longest waiter still ready at each level has waited
+void print_fairness() {
+    long waiting[FAIR_LEVELS] = {-1, -1, -1, -1};
+    for(int level = LOW; level <= HIGH; level++) {
+        Waitq_node* node = Waitq_peek(&readyWaiters[level]);
+        if(node != NULL)
+            waiting[level] = simTime - ((PCB*)node->item)->readySince;
+        if(starveThreshold > 0)
+            continue;
+        List* queue = ready_queue(level);   // Not tracked while alarms are off, so scanned
+        for(PCB* process = List_first(queue); process != NULL; process = List_next(queue)) {
+            if(process->readySince >= 0 && simTime - process->readySince > waiting[level])
+                waiting[level] = simTime - process->readySince;
+        }
+    }
+    List* queues[] = {dlQueue, rtQueue};    // Kept in deadline or real-time priority order, so scanned
+    for(int i = 0; i < 2; i++) {
+        for(PCB* process = List_first(queues[i]); process != NULL; process = List_next(queues[i])) {
+            if(process->readySince >= 0 && simTime - process->readySince > waiting[FAIR_REALTIME])
+                waiting[FAIR_REALTIME] = simTime - process->readySince;
+        }
+    }
+    Fair_print_stats(waiting);
+}
@@ -1,117 +1,638 @@
-#ifndef _COMMANDS_H_
-#define _COMMANDS_H_
-#include "list.h"
-#include "PCB.h"
-#include "semaphore.h"
-#include <stdbool.h>
-
-struct semaphore{
-    int value;
-    List* semQueue;
-    bool active;
-};
-typedef struct semaphore semaphore;
-
-static List* highQueue;
-static List* medQueue;
-static List* lowQueue;
-static List* recvQueue;
-static List* sendQueue;
-static semaphore sem[5];
-static PCB* init;
-static PCB* curr;
-static bool sysRunning = true;
-
-// Initialize the simulator (ready/blocked queues, semaphores, etc.)
-void start_simulator();
-
-// Read user inputs and execute the commands
-void read_cmd();
-
-// (C) Create a process with the given priority and add it to the appropriate ready Q
-// Report success/failure and return the PID of the created process
-// If no other process is running, except the init process, run the new process
-void Create(int priority);
-
-// (F) Copy current process and put it into the ready Q with original process' priority
-// Report success/failure and return the PID of the created process
-// Forking init process should fail
-void Fork();
-
-// (K) Kill the named process and remove it from the system
-// Report success or failure
-// Allows you to kill a process even when it is not currently executing (e.g. in blocked queue)
-void Kill(int pid);
-
-// (E) Only Kill the current process
-// Report process scheduling info (e.g. which process now takes over the CPU)
-void Exit();
-
-// (Q) Time quantum for currently running process expires
-// Report action taken (e.g. process scheduling info)
-// ONLY way to signal that the time quantum for round robin scheduling has expired
-//  - when this occurs we must choose the next process to execute from the appropriate ready queue
-//      (or just the init process if no processes are ready)
-//  - when a new process becomes ready of a higher priority than the currently executing process, you
-//      do NOT need to pre-empt the currently executing process; just wait until quantum expires
-void Quantum();
-
-// (S) Sends a message to specified process, place in blocked queue till reply is received
-// Report success/failure, scheduling info, and reply message and sender's PID (once received)
-// sends the message to the named process and places the sender on a blocked queue
-//  - you must put the message somewhere so that the named process will be able to receive it when it
-//      is next executed
-void Send(int pid, char* msg);
-
-// (R) Receive a message, place in blocked queue till message is received 
-// Report scheduling info and message and sender's PID (once received)
-// Else, put process into the blocked queue to wait for a "Send".
-//  -checks if there is a message waiting for the currently executing process, if there is, it
-//      receives it, otherwise it gets blocked
-void Receive();
-
-// (Y) Delivers reply to sender (works similar to Send) and unblocks the sender
-// Report success/failure
-void Reply(int pid, char* msg);
-
-// (N) Initializes the named semaphore with the value given.
-// ID's can take a value from 0 to 4. Can only be done once per semaphore.
-// Report success/failure and action taken (e.g. scheduling info)
-void New_sem(int semID, int value);
-
-// (P) Executes semaphore P(block) operation on the named semaphore
-// Report action taken(blocked/unblocked) and success/failure
-void Sem_P(int sem_ID);
-
-// (V) Executes semaphore V(unblock) operation on the named semaphore
-// Report action taken(weather/which process was readied) and success/failure
-void Sem_V(int sem_ID);
-
-// (I) Prints the complete state info of process to the screen
-// Report action
-void Procinfo(int pid);
-
-// (T) Displays all process queues and their contents
-void Totalinfo();
-
-// -------------------------------------- Helper Functions --------------------------------------
-
-// Function to compare integers, used by search_process().
-bool compare_int(void* pItem, void* pComp);
-
-// Search all queues for the process with the given pid
-// Returns a pointer to the queue with process as the current item return NULL if not found
-List* search_process(int pid);
-
-// Selects a process from the ready queues based on priority and sets it to running
-// If there is no process ready, switch to "init" process
-// Print process_msg of the new process if it exists
-void switch_process();
-
-// Function to print the processes of a given queue, used by Totalinfo()
-void print_queue(List* queue);
-
-// Callback function to free a PCB, used by List_free()
-void free_item(void *pItem);
-
+#ifndef _COMMANDS_H_
+#define _COMMANDS_H_
+#include "list.h"
+#include "PCB.h"
+#include "semaphore.h"
+#include "device.h"
+#include "event.h"
+#include "burst.h"
+#include "replay.h"
+#include "trace.h"
+#include "channel.h"
+#include "topic.h"
+#include "fairness.h"
+#include "cgroup.h"
+#include "energy.h"
+#include <stdbool.h>
+
+// Queue IDs for snapshots: the watched queues, then the semaphore queues, then pseudo queues
+#define SNAP_LISTS 16
+#define SNAP_READY_LISTS 5  // The first watched queues are the ready queues
+#define SNAP_DEADLINE 0     // Watched queue indices of the queues looked up by process
+#define SNAP_WAIT 7
+#define SNAP_FAULT 8
+#define SNAP_SLEEP 9
+#define SNAP_IO 13
+#define SNAP_THROTTLE 15
+#define SNAP_QUEUES (SNAP_LISTS + 5)
+#define SNAP_RUNNING SNAP_QUEUES
+#define SNAP_EXITED (SNAP_QUEUES + 1)
+
+// A process that may have changed queue since the last snapshot
+struct Snap_change{
+    int pid;        // Looked up again when needed, PIDs are never reused
+    int from;       // Queue at the snapshot
+}; typedef struct Snap_change Snap_change;
+
+struct semaphore{
+    int value;
+    List* semQueue;
+    bool active;
+    int holders;    // Processes holding units of the semaphore, counted in their semHeld
+    long holderSum; // Sum of the holders' PIDs, names the holder when there is exactly one
+    PCB* owner;     // The holder when there is exactly one, else NULL
+    Wfg_node wait;  // Waits for the owner, blocked processes wait for this node
+    enum waitq_order order; // Order blocked processes are woken in
+    Waitq waiters;  // Blocked processes in wake order, semQueue keeps them in arrival order
+};
+typedef struct semaphore semaphore;
+
+// Status returned by every command (Create and Fork return the new PID instead of SCHED_SUCCESS)
+#define SCHED_SUCCESS 0
+#define SCHED_FAIL -1
+
+// Share of the CPU deadline processes may reserve, the rest is kept for the other classes
+#define DL_MAX_BANDWIDTH 0.95
+
+// Scheduling events passed to the event callback, with the PID of the process and the time
+enum sched_event{
+    SCHED_CREATE,   // A process was created (by a command, an arrival, a fork or a trace)
+    SCHED_READY,    // A process was placed on a ready queue
+    SCHED_DISPATCH, // A process was given the CPU (PID 0 when init runs)
+    SCHED_BLOCK,    // The running process blocked
+    SCHED_EXIT,     // A process left the system
+    SCHED_STARVE    // A ready process has waited longer than the starvation threshold
+};
+typedef void (*SCHED_EVENT_FN)(enum sched_event event, int pid, long time, void* context);
+
+// Actions applied to every member of a process group in a single sweep of the queues
+enum group_action{
+    GROUP_KILL, GROUP_SUSPEND, GROUP_RESUME, GROUP_PRIORITY
+};
+
+// The commands below make up the scheduler library, the command line front end (cli.c) only reads
+// their parameters. Each one reports its result on stdout unless reports are turned off and returns
+// SCHED_SUCCESS or SCHED_FAIL
+
+// Initialize the simulator (ready/blocked queues, semaphores, etc.)
+void start_simulator();
+
+// Frees every queue, semaphore and open channel or topic once the simulation is over
+void stop_simulator();
+
+// Returns false once the init process has exited
+bool Sched_running();
+
+// Returns the simulated time in ticks
+long Sched_time();
+
+// Returns the PID of the running process (0 = init)
+int Sched_current();
+
+// Calls fn with context for every scheduling event from now on (NULL = no callback)
+void Sched_on_event(SCHED_EVENT_FN fn, void* context);
+
+// Turns the text reports of the commands on or off, they are on by default
+void Sched_set_reports(bool on);
+
+// Returns the wait order of the semaphore (see Configure_sem_order), SCHED_FAIL for an invalid ID
+int Sem_order(int semID);
+
+// (C) Create a process with the given priority and add it to the appropriate ready Q
+// Report success/failure and return the PID of the created process
+// If no other process is running, except the init process, run the new process
+int Create(int priority);
+
+// (C) Create a real-time FIFO or RR process with a real-time priority from RT_MIN_PRIORITY to
+// RT_MAX_PRIORITY. Real-time processes preempt normal ones and lower real-time priorities
+// Report success/failure and return the PID of the created process
+int Create_rt(int policy, int rtPriority);
+
+// (C) Create a deadline process that is guaranteed runtime ticks before deadline in every period.
+// The process is admitted only if the runtime/min(deadline, period) of every deadline process adds
+// up to no more than DL_MAX_BANDWIDTH. Its runtime is enforced by a constant bandwidth server: a
+// process that uses it up is throttled until its next period, and one that wakes up too late to
+// finish in the rest of its reservation gets a fresh deadline
+// Report success/failure and return the PID of the created process
+int Create_deadline(long runtime, long deadline, long period);
+
+// (F) Copy current process and put it into the ready Q with original process' priority
+// Report success/failure and return the PID of the created process
+// Forking init process should fail
+int Fork();
+
+// (K) Kill the named process and remove it from the system
+// Report success or failure
+// Allows you to kill a process even when it is not currently executing (e.g. in blocked queue)
+int Kill(int pid);
+
+// (E) Only Kill the current process
+// Report process scheduling info (e.g. which process now takes over the CPU)
+int Exit();
+
+// (Q) Time quantum for currently running process expires
+// Report action taken (e.g. process scheduling info)
+// Advances simulated time to the end of the running process' quantum (or by one quantum if init
+// is running), handling any events due on the way
+//  - when this occurs we must choose the next process to execute from the appropriate ready queue
+//      (or just the init process if no processes are ready)
+//  - when a new process becomes ready of a higher priority than the currently executing process, it
+//      waits until the quantum expires unless preemptive mode is on (see Configure_preemption)
+int Quantum();
+
+// (S) Sends a message to specified process, place in blocked queue till reply is received
+// Report success/failure, scheduling info, and reply message and sender's PID (once received)
+// sends the message to the named process and places the sender on a blocked queue
+//  - you must put the message somewhere so that the named process will be able to receive it when it
+//      is next executed
+int Send(int pid, char* msg);
+
+// (R) Receive a message, place in blocked queue till message is received 
+// Report scheduling info and message and sender's PID (once received)
+// Else, put process into the blocked queue to wait for a "Send".
+//  -checks if there is a message waiting for the currently executing process, if there is, it
+//      receives it, otherwise it gets blocked
+int Receive();
+
+// (Y) Delivers reply to sender (works similar to Send) and unblocks the sender
+// Report success/failure
+int Reply(int pid, char* msg);
+
+// (N) Initializes the named semaphore with the value given.
+// ID's can take a value from 0 to 4. Can only be done once per semaphore.
+// Report success/failure and action taken (e.g. scheduling info)
+int New_sem(int semID, int value);
+
+// (P) Executes semaphore P(block) operation on the named semaphore. On a deadline ordered
+// semaphore a blocked process is woken by deadline ticks from now (0 = no deadline, woken last)
+// Report action taken(blocked/unblocked) and success/failure
+int Sem_P(int sem_ID, long deadline);
+
+// (V) Executes semaphore V(unblock) operation on the named semaphore
+// Report action taken(weather/which process was readied) and success/failure
+int Sem_V(int sem_ID);
+
+// (J) Opens a named channel holding up to capacity messages
+// Report success/failure
+int Chan_create(char* name, int capacity);
+
+// (J) Sends msg on the named channel without waiting for a reply. The message goes straight to a
+// waiting receiver or into the buffer, the sender only blocks while the buffer is full
+// Report success/failure
+int Chan_send(char* name, char* msg);
+
+// (J) Takes the oldest message off the named channel, blocking while it is empty
+// Report success/failure
+int Chan_receive(char* name);
+
+// (Z) Opens a named publish/subscribe topic
+// Report success/failure
+int Topic_create(char* name);
+
+// (Z) Subscribes or unsubscribes the running process to the named topic
+// Report success/failure
+int Topic_join(char* name, bool subscribe);
+
+// (Z) Publishes msg to every subscriber of the named topic as one shared message, every receiver
+// blocked on the topic is readied as one batch with a single dispatch
+// Report how many subscribers it reached and success/failure
+int Topic_send(char* name, char* msg);
+
+// (Z) Takes the oldest unread publication of the named topic, blocking while there is none
+// Report success/failure
+int Topic_recv(char* name);
+
+// (H) Executes count V operations on the named semaphore in one call (0 = broadcast, wake every
+// waiter), the woken processes are readied as one batch with a single dispatch
+// Report how many processes were readied and success/failure
+int Sem_V_n(int semID, int count);
+
+// (W) Wait for a child of the current process to exit
+// Reaps an exited (zombie) child straight away, otherwise blocks until a child exits
+// Report success/failure and the PID of the reaped child
+int Wait();
+
+// (G) Process group operations, each done in one pass over all queues
+// Report success/failure and the number of processes affected
+// Kill every process in the group (including the running one) and remove them from the system
+int Kill_group(int groupID);
+
+// Take every process in the group off the ready queues and hold it on the suspend queue
+// Blocked members stay blocked, but are suspended instead of readied when unblocked
+int Suspend_group(int groupID);
+
+// Return every suspended process in the group to its ready queue
+int Resume_group(int groupID);
+
+// Change the priority of every process in the group, moving ready members to the new ready queue
+int Priority_group(int groupID, int priority);
+
+// (M) Current process reads or writes the given virtual page of its address space
+// Report hit/fault, a page fault blocks the process for the configured fault latency
+// (init takes the fault without blocking). The first write to an address space shared with a
+// forked relative copies it, which is taken like a page fault
+int Access(int vpn, bool write);
+
+// (O) Configure the memory manager: number of physical frames, replacement policy (0 = LRU, 1 = CLOCK,
+// 2 = ARC), page fault latency and working set window in ticks. All resident pages are evicted
+// Report success/failure
+int Configure_memory(int frames, int policy, int latency, long window);
+
+// (D) Current process issues an I/O request for the given sector/block to the named device
+// and blocks until the device completes it (init cannot issue I/O)
+// Report success/failure and scheduling info
+int Device_io(int deviceID, int sector);
+
+// (O) Configure an I/O device: type (0 = block, 1 = network), queue discipline
+// (0 = FIFO, 1 = elevator, 2 = deadline), service time distribution (0 = fixed, 1 = uniform,
+// 2 = exponential), mean service time and deadline in ticks. The device must be idle
+// Report success/failure
+int Configure_device(int deviceID, int type, int discipline, int distribution, int meanService, int deadline);
+
+// (O) Sets the order the semaphore wakes blocked processes in (FIFO, priority or deadline),
+// only while no process is blocked on it
+// Report success/failure
+int Configure_sem_order(int semID, int order);
+
+// (A) Schedules the arrival of a new process with the given priority delay ticks from now
+// Report success/failure
+int Arrival(int priority, long delay);
+
+// (L) Streams a scheduler trace into the simulation: traced tasks become processes that are
+// created, forked, blocked, woken and killed at the trace's timestamps (usPerTick microseconds
+// of trace time per tick) while the simulator's own scheduler decides who runs
+// Report success/failure
+int Import_trace(char* path, long usPerTick);
+
+// (X) Runs the discrete-event simulation for the given number of ticks
+// Report the events handled and the time reached
+int Run(long duration);
+
+// (O) Set the number of ticks in a time quantum of a priority level (3 = all levels),
+// takes effect from the next dispatch
+// Report success/failure
+int Configure_quantum(int priority, long length);
+
+// (U) Moves every ready process to the high priority queue (MLFQ priority boost).
+// Each process on the medium and low queues is raised to high priority, then both queues are
+// spliced onto the high queue. O(n log n) in the processes moved: the walk is O(n) and the queue
+// watcher moves each process' ready-wait entry between the per-level heaps
+int Boost();
+
+// (O) Boost priorities every period ticks (0 = never)
+// Report success/failure
+int Configure_boost(long period);
+
+// (O) Raise a starvation alarm when a ready process has waited threshold ticks (0 = never).
+// Checked at every dispatch against the front of each ready queue, where the longest waiter is
+// Report success/failure
+int Configure_starvation(long threshold);
+
+// (O) Create control group name under parent ("/" = root) with a weight from 1 to CG_MAX_WEIGHT.
+// The quantum of a member process is scaled by weight/CG_DEFAULT_WEIGHT for its group and each
+// ancestor, so busy groups at the same priority share the CPU in proportion to their weights
+// Report success/failure
+int Cgroup_create(char* name, char* parent, int weight);
+
+// (O) Limits control group name and everything below it to quota ticks of runtime every period
+// ticks (quota 0 = no limit). Once the quota is used up the members of the group are held off the
+// CPU until the next period. Deadline processes are not limited, they have their own reservation
+// Report success/failure
+int Cgroup_limit(char* name, long quota, long period);
+
+// (O) Moves process pid into control group name
+// Report success/failure
+int Cgroup_attach(int pid, char* name);
+
+// (O) Turns preemptive mode on or off. In preemptive mode a process that becomes ready with a higher
+// priority than the running one takes the CPU at once, provided the running process has had at
+// least granularity ticks since it was dispatched; otherwise it takes the CPU once they have passed.
+// Real-time and deadline processes always preempt normal ones, with no granularity
+// Report success/failure
+int Configure_preemption(bool on, long granularity);
+
+// (O) Sets the context switch cost model: a fixed overhead, a cache warm-up penalty that grows to
+// cache ticks for a process that has been off the CPU for decay ticks, and a TLB flush when the
+// address space changes. Switch time is charged to simulated time before the process runs
+// Report success/failure
+int Configure_switch_cost(long overhead, long cache, long decay, long tlb);
+
+// (O) Replaces the P-state table of the CPU with count states, fastest first. speed is a percentage
+// of full speed: a process runs its CPU bursts speed/100 as fast, and the state draws power per tick
+// Report success/failure
+int Configure_pstates(int count, int* speed, int* power);
+
+// (O) Replaces the C-state table with count idle states, shallowest first. When init is dispatched
+// the CPU enters the deepest state whose target residency fits before the next pending event, and
+// the next process dispatched waits out that state's exit latency before it runs
+// Report success/failure
+int Configure_cstates(int count, int* power, int* latency, int* residency);
+
+// (O) Sets the governor that picks a P-state at every dispatch. Performance races to idle so the
+// CPU can sleep in deep C-states, powersave always runs slowest, ondemand runs fast only while
+// other processes are waiting
+// Report success/failure
+int Configure_governor(int governor);
+
+// (O) Set the burst model given to processes created by arrivals (NULL = none)
+// Report success/failure
+int Configure_arrivals(Burst* model);
+
+// (B) Give the named process a scripted workload of alternating CPU and I/O burst lengths
+// Report success/failure
+int Set_burst_script(int pid, char* script, int device);
+
+// (B) Give the named process a random workload of count exponential CPU bursts separated by
+// exponential I/O bursts, I/O goes to the given device (-1 = timed wait)
+// Report success/failure
+int Set_burst_random(int pid, long meanCpu, long meanIo, int count, int device);
+
+// (I) Prints the complete state info of process to the screen
+// Report action
+int Procinfo(int pid);
+
+// (T) Displays all process queues and their contents
+int Totalinfo();
+
+// (O) Writes every queue to path as JSON and makes it the baseline for Snapshot_diff(). Queue
+// changes are tracked as processes are added to and taken out of queues
+// Report success/failure
+int Snapshot(char* path);
+
+// (O) Reports the processes that changed queue since the last snapshot. The cost depends on the
+// number of processes that moved, not on the number in the queues. Fails, still listing the
+// changes it has, if a change could not be recorded for lack of memory
+// Report success/failure
+int Snapshot_diff();
+
+// -------------------------------------- Helper Functions --------------------------------------
+
+// Reports a replay that no longer matches its recording (at an input, or at a dispatch where
+// the recording dispatched recPid at recTime) and exits with a failure status
+void replay_diverged(bool atInput, long recTime, int recPid);
+
+// Function to compare integers, used by search_process().
+bool compare_int(void* pItem, void* pComp);
+
+// Matches processes of the group pointed to by pComp
+bool compare_group(void* pItem, void* pComp);
+
+// Returns the priority level of a ready queue, -1 for any other queue
+int queue_priority(List* queue);
+
+// Search all queues for the process with the given pid
+// Returns a pointer to the queue with process as the current item return NULL if not found
+List* search_process(int pid);
+
+// Selects a process from the ready queues based on priority and sets it to running
+// If there is no process ready, switch to "init" process
+// Print process_msg of the new process if it exists
+void switch_process();
+
+// Places a process on the ready queue for its priority and sets it to ready
+// Processes of a suspended group go to the suspend queue instead
+// Returns SCHED_FAIL, after reporting it, if the queue could not grow to take the process
+int make_ready(PCB* process);
+
+// Sets a queue node aside for the running process, reports and returns false if it has to keep the CPU
+bool reserve_curr(const char* action);
+
+// Returns the ready queue for the given priority
+List* ready_queue(int priority);
+
+// Raises every process on the given lower ready queue to high priority, returns how many there are
+int boost_queue(List* queue);
+
+// Walks the queue once and applies the group action to every member of the group
+// Returns the number of processes affected
+int sweep_group(List* queue, int groupID, enum group_action action, int priority);
+
+// Applies the group action to every queue in the system, returns the number of processes affected
+int sweep_all(int groupID, enum group_action action, int priority);
+
+// Removes a process from the system once it is off every queue
+// Children are reparented to init, the process stays a zombie until its parent reaps it
+// (processes whose parent is init are freed straight away)
+void terminate_process(PCB* process);
+
+// Handles every pending event up to time until in time order and advances the clock to until
+// Returns the number of events handled
+int run_until(long until);
+
+// Handles a single event at the current simulated time
+void handle_event(Event* ev);
+
+// Ends the running process' quantum: it goes to the back of its ready queue and the next one runs
+void expire_quantum();
+
+// Starts a new quantum for the running process, scheduling its expiry event
+// (or the end of its CPU burst if that comes first)
+void start_quantum();
+
+// Returns the ticks it takes to switch to process under the context switch cost model
+long switch_cost(PCB* process);
+
+// Returns the time slice of the running process: its deadline runtime, its quantum, or LONG_MAX for FIFO
+long time_slice(PCB* process);
+
+// Inserts a real-time or deadline process into its ready queue, by real-time priority or earliest
+// deadline. A preempted process goes ahead of its equals, any other behind them
+// Returns LIST_SUCCESS or LIST_FAIL
+int enqueue_ordered(PCB* process, bool ahead);
+
+// Preempts the running process if a ready process outranks it, waiting out the wakeup granularity
+void check_preempt();
+
+// Returns the process switch_process() would pick next without removing it, NULL if nothing is ready
+PCB* peek_ready();
+
+// Returns whether a ready process should take the CPU from the running one
+bool outranks(PCB* process, PCB* running);
+
+// Puts the running process back at the front of its ready queue and switches to the next process
+void preempt_curr();
+
+// Creates a process and either runs it straight away or readies it
+PCB* create_policy_process(int policy, int rtPriority, long runtime, long deadline, long period);
+
+// Runs a new process straight away if init is running, otherwise places it on its ready queue
+// Returns SCHED_FAIL if it could not be queued
+int start_process(PCB* process);
+
+// Takes back a new process that could not be queued, undoing its creation
+void discard_process(PCB* process);
+
+// Starts a new reservation of a deadline process with its deadline at absDeadline
+void set_deadline(PCB* process, long absDeadline);
+
+// Applies the constant bandwidth server wake-up rule to a deadline process becoming ready
+void cbs_wakeup(PCB* process);
+
+// Takes the next process off the ready queues and makes it the running process
+void pick_next();
+
+// Keeps a process of a throttled control group off the ready queues until the group is refilled
+void hold_back(PCB* process);
+
+// Holds the running process off the CPU until its control group is refilled
+void park_curr();
+
+// Readies the held off processes whose control groups are no longer throttled
+int release_throttled();
+
+// Takes the running deadline process off the CPU until its next period
+void throttle_curr();
+
+// Counts a deadline that passed while the process still had runtime left
+void check_deadline(int pid);
+
+// Gives a throttled deadline process its next reservation
+void replenish(int pid);
+
+// Returns slice scaled by the weights of the process' cgroups and bounded by their quota
+long cgroup_slice(PCB* process, long slice);
+
+// Returns the ticks it takes process to finish its burst at the current CPU speed
+long burst_ticks(PCB* process);
+
+// Returns the quantum length for the given priority level
+long quantum_length(int priority);
+
+// Charges the time since the running process was dispatched to it and to the CPU busy time
+void account_cpu();
+
+// The running process finished its CPU burst: it blocks for its next I/O burst, yields, or exits
+// once its workload is complete
+void end_burst();
+
+// Attaches model to process, replacing any earlier one, and starts its first CPU burst
+int attach_burst(PCB* process, Burst* model);
+
+// Creates a process with the given priority and burst model (may be NULL), runs it if init
+// is running, otherwise places it on its ready queue. Returns the process or NULL if failed
+PCB* create_process(int priority, Burst* model);
+
+// Finds a live process by PID (running or on any queue), NULL if not found
+PCB* find_process(int pid);
+
+// Forks parent, the child joins the parent's group and is placed on its ready queue
+// Returns the child or NULL if failed
+PCB* fork_process(PCB* parent);
+
+// Hands the CPU to a ready process if init is running or a ready process outranks the running one
+void dispatch_if_idle();
+
+// Applies one trace event to the simulation
+void apply_trace_event(Trace* trace, Trace_event* ev);
+
+// Returns the process standing in for trace pid, creating it on first sight (NULL if failed)
+PCB* trace_process(Trace* trace, int pid, int prio);
+
+// Blocks a running or ready process until the trace wakes it
+void trace_block(PCB* process);
+
+// Readies a process blocked by trace_block()
+void trace_unblock(PCB* process);
+
+// Moves the first sender blocked on the full channel into its buffer and readies it
+void admit_chan_sender(int chanID);
+
+// Matches processes blocked on the channel pointed to by pComp
+bool compare_chan(void* pItem, void* pComp);
+
+// Readies every receiver blocked on the topic, each takes its next publication
+// Returns the number woken
+int wake_topic_receivers(int topicID);
+
+// Matches processes blocked on the topic pointed to by pComp
+bool compare_topic(void* pItem, void* pComp);
+
+// Readies up to count waiters in the semaphore's wait order, each becomes a holder
+// Returns the number woken
+int wake_sem_waiters(int semID, int count);
+
+// Blocks process on the semaphore, keyed by its wait order
+// Returns SCHED_FAIL, leaving the semaphore unchanged, if the queue node could not be allocated
+int sem_enqueue(int semID, PCB* process, long deadline);
+
+// Takes the next waiter in wait order off the semaphore, NULL if there is none
+PCB* sem_dequeue(int semID);
+
+// Keeps the semaphore's wait order in step with a group sweep, killed waiters leave it and
+// waiters given a new priority are ordered again
+void sem_sweep_waiters(int semID, int groupID, enum group_action action, int priority);
+
+// Prints the semaphore's queue in arrival order and the process it wakes next
+void print_sem_queue(int semID);
+
+// Points the semaphore's wait-for edge at its owner, or removes it if there is no single owner
+void update_sem_edge(int semID);
+
+// Gives process delta more units of the semaphore (or takes -delta back, as many as it holds)
+// and updates its holders and owner. Returns the number of units moved
+int sem_hold(int semID, PCB* process, int delta);
+
+// Makes process wait for target in the wait-for graph, reporting a deadlock if that closes a cycle
+void wait_for(PCB* process, Wfg_node* target);
+
+// Removes every wait-for edge from and to a process that is being terminated
+void release_waits(PCB* process);
+
+// Prints the cycle of the wait-for graph that starts at node, with the PIDs and semaphores on it
+void report_deadlock(Wfg_node* node);
+
+// Schedules an event for the earliest time a busy device finishes its request
+void schedule_device();
+
+// Readies every process whose I/O request has completed, returns the number readied
+int collect_io();
+
+// Function to print the processes of a given queue, used by Totalinfo()
+void print_queue(List* queue);
+
+// Callback function to free a PCB, used by List_free()
+void free_item(void *pItem);
+
+// Watcher of the queues, keeps the queue of a process up to date and records it as changed
+void queue_changed(void* item, Node* node, void* arg, bool added);
+
+// Takes process off the watched queue if it is on it, in O(1). Returns whether it was there
+bool take_from(PCB* process, int queue);
+
+// Keeps the waiters of a normal ready level in order of readySince as processes join and leave it
+void track_ready(PCB* process, int level, bool added);
+
+// Records that process may have changed queue since the last snapshot
+void snap_changed(PCB* process);
+
+// Returns the live process with PID pid for the snapshot diff, NULL once it has exited
+PCB* snap_find(int pid);
+
+// Frees process, remembering for the snapshot diff that it exited
+void release_process(PCB* process);
+
+// Returns the name of a queue ID for snapshots
+const char* snap_name(int queue);
+
+// Schedules an event of the given type, reporting the loss of what it stands for if the event
+// queue cannot grow. Returns whether the event was scheduled
+bool schedule(long time, int type, int arg, const char* what);
+
+// Schedules an event like schedule() and ties it to timer (NULL = none), replacing the event
+// already tied to it
+bool schedule_timer(Event_timer* timer, long time, int type, int arg, const char* what);
+
+// Passes a scheduling event to the event callback, if there is one
+void notify(enum sched_event event, int pid);
+
+// Records how long the process being dispatched waited and raises a starvation alarm for any
+// ready level whose longest waiter has waited past the threshold
+void check_waits(PCB* process);
+
+// Returns the fairness level a process is counted at (FAIR_REALTIME for deadline and real-time processes)
+int fair_level(PCB* process);
+
+// Prints the fairness statistics, counting the current wait of processes that are still ready
+void print_fairness();
+
 #endif
\ No newline at end of file
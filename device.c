@@ -0,0 +1,279 @@
+#include "device.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "random.h"
+
+struct Request_s{
+    void* owner;    // NULL once the owner has been cancelled
+    int sector;
+    long issueTime;
+    long seq;       // Arrival order, used by FIFO
+}; typedef struct Request_s Request;
+
+struct Device_s{
+    bool active;
+    int type;
+    int discipline;
+    int distribution;
+    int meanService;
+    int deadline;
+    // Queued requests, unordered; the discipline picks the next one
+    Request* queue;
+    int count;
+    int capacity;
+    // Request in service
+    bool busy;
+    Request current;
+    long finishTime;
+    // Elevator state
+    int headSector;
+    bool goingUp;
+    // Statistics
+    long started;
+    long completed;
+    long totalWait;     // Queueing delay of every started request
+    long busyTime;
+}; typedef struct Device_s Device;
+
+static Device devices[DEV_MAX_DEVICES];
+static long nextSeq = 0;
+
+// Completion queue, ring buffer of owners
+static void** completions = NULL;
+static int compHead = 0;
+static int compCount = 0;
+static int compCapacity = 0;
+static int compReserved = 0;    // Submitted requests not yet completed, each has a slot set aside
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// Samples a service time (at least 1) from the device's distribution
+static int sampleService(Device* dev) {
+    int mean = dev->meanService;
+    if(dev->distribution == DEV_UNIFORM)    // Uniform on [1, 2 * mean - 1]
+        return 1 + (int)(Random_next() % (unsigned long)(2 * mean - 1));
+    if(dev->distribution == DEV_EXPONENTIAL)
+        return (int)Random_exponential(mean);
+    return mean;
+}
+
+// Grows the completion ring to hold at least needed owners, unwrapping it into the new buffer
+static bool growCompletions(int needed) {
+    if(needed <= compCapacity)
+        return true;
+    int newCapacity = compCapacity ? compCapacity : 16;
+    while(newCapacity < needed)
+        newCapacity *= 2;
+    void** grown = malloc(newCapacity * sizeof(void*));
+    if(grown == NULL)
+        return false;
+    for(int i = 0; i < compCount; i++)
+        grown[i] = completions[(compHead + i) % compCapacity];
+    free(completions);
+    completions = grown;
+    compCapacity = newCapacity;
+    compHead = 0;
+    return true;
+}
+
+// Hands back a finished request, its slot was reserved when it was submitted
+static void pushCompletion(void* owner) {
+    completions[(compHead + compCount) % compCapacity] = owner;
+    compCount++;
+}
+
+// Picks the request closest to the head in the current direction, reversing at the end
+static int pickElevator(Device* dev) {
+    for(int pass = 0; pass < 2; pass++) {
+        int best = -1;
+        for(int i = 0; i < dev->count; i++) {
+            int dist = dev->queue[i].sector - dev->headSector;
+            if(!dev->goingUp)
+                dist = -dist;
+            if(dist < 0)
+                continue;
+            int bestDist = best < 0 ? 0 : dev->queue[best].sector - dev->headSector;
+            if(!dev->goingUp)
+                bestDist = -bestDist;
+            if(best < 0 || dist < bestDist || (dist == bestDist && dev->queue[i].seq < dev->queue[best].seq))
+                best = i;
+        }
+        if(best >= 0)
+            return best;
+        dev->goingUp = !dev->goingUp;
+    }
+    return 0;
+}
+
+// Returns the index of the next request to service according to the discipline
+static int pickNext(Device* dev, long now) {
+    int best = 0;
+    if(dev->discipline == DEV_DEADLINE) {   // Expired requests first, oldest deadline wins
+        int expired = -1;
+        for(int i = 0; i < dev->count; i++) {
+            if(dev->queue[i].issueTime + dev->deadline <= now &&
+                (expired < 0 || dev->queue[i].seq < dev->queue[expired].seq))
+                expired = i;
+        }
+        if(expired >= 0)
+            return expired;
+        return pickElevator(dev);
+    }
+    if(dev->discipline == DEV_ELEVATOR)
+        return pickElevator(dev);
+    for(int i = 1; i < dev->count; i++) {   // FIFO
+        if(dev->queue[i].seq < dev->queue[best].seq)
+            best = i;
+    }
+    return best;
+}
+
+// Starts servicing the next queued request at time start, if there is one
+static void startNext(Device* dev, long start) {
+    if(dev->count == 0) {
+        dev->busy = false;
+        return;
+    }
+    int i = pickNext(dev, start);
+    dev->current = dev->queue[i];
+    dev->queue[i] = dev->queue[--dev->count];   // Queue is unordered, fill the hole with the last one
+    int service = sampleService(dev);
+    dev->busy = true;
+    dev->finishTime = start + service;
+    dev->headSector = dev->current.sector;
+    dev->started++;
+    dev->totalWait += start - dev->current.issueTime;
+    dev->busyTime += service;
+}
+
+// ---------------------------------------- Device functions --------------------------------------
+
+// Sets up the default devices
+void Dev_init() {
+    for(int i = 0; i < DEV_MAX_DEVICES; i++) {
+        free(devices[i].queue);
+        devices[i] = (Device){0};
+        devices[i].goingUp = true;
+    }
+    compHead = compCount = compReserved = 0;    // Requests of the previous run are gone
+    Dev_configure(0, DEV_BLOCK, DEV_FIFO, DEV_FIXED, 2, 0);
+    Dev_configure(1, DEV_NETWORK, DEV_FIFO, DEV_EXPONENTIAL, 1, 0);
+}
+
+// (Re)configures device id, the device must be idle
+int Dev_configure(int id, int type, int discipline, int distribution, int meanService, int deadline) {
+    if(id < 0 || id >= DEV_MAX_DEVICES || meanService < 1 || deadline < 0 ||
+        (type != DEV_BLOCK && type != DEV_NETWORK) ||
+        discipline < DEV_FIFO || discipline > DEV_DEADLINE ||
+        distribution < DEV_FIXED || distribution > DEV_EXPONENTIAL)
+        return DEV_FAIL;
+    Device* dev = &devices[id];
+    if(dev->busy || dev->count > 0)
+        return DEV_FAIL;
+    dev->active = true;
+    dev->type = type;
+    dev->discipline = discipline;
+    dev->distribution = distribution;
+    dev->meanService = meanService;
+    dev->deadline = deadline;
+    return DEV_SUCCESS;
+}
+
+// Queues a request for sector on device id on behalf of owner
+int Dev_submit(int id, void* owner, int sector, long now) {
+    if(id < 0 || id >= DEV_MAX_DEVICES || !devices[id].active)
+        return DEV_NO_DEVICE;
+    Device* dev = &devices[id];
+    if(dev->count == dev->capacity) {
+        int newCapacity = dev->capacity ? dev->capacity * 2 : 8;
+        Request* grown = realloc(dev->queue, newCapacity * sizeof(Request));
+        if(grown == NULL)
+            return DEV_NO_MEMORY;
+        dev->queue = grown;
+        dev->capacity = newCapacity;
+    }
+    if(!growCompletions(compCount + compReserved + 1))
+        return DEV_NO_MEMORY;
+    compReserved++;
+    Request req = {owner, dev->type == DEV_NETWORK ? 0 : sector, now, nextSeq++};
+    dev->queue[dev->count++] = req;
+    if(!dev->busy)
+        startNext(dev, now);
+    return DEV_SUCCESS;
+}
+
+// Drops every request of owner (queued or in service)
+void Dev_cancel(void* owner) {
+    for(int d = 0; d < DEV_MAX_DEVICES; d++) {
+        Device* dev = &devices[d];
+        if(dev->busy && dev->current.owner == owner)
+            dev->current.owner = NULL;  // Device still finishes the transfer, nobody is woken
+        for(int i = 0; i < dev->count; ) {
+            if(dev->queue[i].owner == owner) {
+                dev->queue[i] = dev->queue[--dev->count];
+                compReserved--; // Will never complete
+            } else
+                i++;
+        }
+    }
+    for(int i = 0; i < compCount; i++) {    // Completed but not yet collected
+        if(completions[(compHead + i) % compCapacity] == owner)
+            completions[(compHead + i) % compCapacity] = NULL;
+    }
+}
+
+// Finishes all requests completed by time now
+void Dev_advance(long now) {
+    for(int d = 0; d < DEV_MAX_DEVICES; d++) {
+        Device* dev = &devices[d];
+        while(dev->busy && dev->finishTime <= now) {
+            compReserved--;
+            if(dev->current.owner)
+                pushCompletion(dev->current.owner);
+            dev->completed++;
+            startNext(dev, dev->finishTime);    // Device was busy until the request finished
+        }
+    }
+}
+
+// Removes and returns the owner of the oldest completed request
+void* Dev_next_completion() {
+    while(compCount > 0) {
+        void* owner = completions[compHead];
+        compHead = (compHead + 1) % compCapacity;
+        compCount--;
+        if(owner)   // Skip cancelled entries
+            return owner;
+    }
+    return NULL;
+}
+
+// Stores the earliest time a busy device finishes its request in time
+bool Dev_next_finish(long* time) {
+    bool found = false;
+    for(int d = 0; d < DEV_MAX_DEVICES; d++) {
+        if(devices[d].busy && (!found || devices[d].finishTime < *time)) {
+            *time = devices[d].finishTime;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Prints the configuration and statistics of every active device
+void Dev_print_stats() {
+    const char* disciplines[] = {"FIFO", "elevator", "deadline"};
+    const char* distributions[] = {"fixed", "uniform", "exponential"};
+    for(int d = 0; d < DEV_MAX_DEVICES; d++) {
+        Device* dev = &devices[d];
+        if(!dev->active)
+            continue;
+        printf("Device %d (%s, %s, %s service, mean %d): %d queued, %s, %ld completed",
+            d, dev->type == DEV_BLOCK ? "block" : "network", disciplines[dev->discipline],
+            distributions[dev->distribution], dev->meanService, dev->count, dev->busy ? "busy" : "idle",
+            dev->completed);
+        if(dev->started > 0)
+            printf(", average wait %.2f, busy for %ld", (double)dev->totalWait / dev->started, dev->busyTime);
+        printf("\n");
+    }
+}
@@ -0,0 +1,56 @@
+// Simulated I/O device header file
+// Devices keep their own request queue and finish requests on the simulated clock, finished
+// requests are handed back through a completion queue
+#ifndef _DEVICE_H_
+#define _DEVICE_H_
+#include <stdbool.h>
+
+#define DEV_MAX_DEVICES 4
+#define DEV_SUCCESS 0
+#define DEV_FAIL -1
+#define DEV_NO_DEVICE -2    // Dev_submit() to a device that does not exist
+#define DEV_NO_MEMORY -3    // Dev_submit() could not make room for the request or its completion
+
+enum dev_type{
+    DEV_BLOCK, DEV_NETWORK
+};
+
+enum dev_discipline{    // Order in which queued requests are serviced
+    DEV_FIFO, DEV_ELEVATOR, DEV_DEADLINE
+};
+
+enum dev_distribution{  // Service time distributions, all with the configured mean
+    DEV_FIXED, DEV_UNIFORM, DEV_EXPONENTIAL
+};
+
+// Sets up the default devices: 0 = block device (FIFO, fixed), 1 = network device (FIFO, exponential)
+void Dev_init();
+
+// (Re)configures device id, the device must be idle
+// deadline is how long a request may wait before the deadline discipline serves it first
+// Returns DEV_SUCCESS or DEV_FAIL
+int Dev_configure(int id, int type, int discipline, int distribution, int meanService, int deadline);
+
+// Queues a request for sector on device id on behalf of owner, issued at time now. Room for its
+// completion is reserved up front, so an accepted request is always handed back
+// Returns DEV_SUCCESS, DEV_NO_DEVICE or DEV_NO_MEMORY
+int Dev_submit(int id, void* owner, int sector, long now);
+
+// Drops every request of owner (queued or in service), used when a process is killed
+void Dev_cancel(void* owner);
+
+// Finishes all requests completed by time now, starting queued ones as devices free up
+// Owners of finished requests are placed on the completion queue
+void Dev_advance(long now);
+
+// Removes and returns the owner of the oldest completed request, NULL if there are none
+void* Dev_next_completion();
+
+// Stores the earliest time a busy device finishes its request in time
+// Returns false if every device is idle
+bool Dev_next_finish(long* time);
+
+// Prints the configuration and statistics of every active device
+void Dev_print_stats();
+
+#endif
@@ -0,0 +1,159 @@
+#include "energy.h"
+#include <stdio.h>
+#include <string.h>
+
+static const int defaultSpeed[] = {100, 80, 60, 40};
+static const int defaultPower[] = {1000, 700, 450, 250};
+// The default idle states cost no wake-up time, so the model does not change timing until it is configured
+static const int defaultIdlePower[] = {300, 100, 20};
+static const int defaultLatency[] = {0, 0, 0};
+static const int defaultResidency[] = {0, 5, 20};
+
+static int numP, speed[ENERGY_MAX_STATES], power[ENERGY_MAX_STATES];
+static int numC, idlePower[ENERGY_MAX_STATES], latency[ENERGY_MAX_STATES], residency[ENERGY_MAX_STATES];
+static int governor;
+
+static bool idle;       // Whether the core is in a C-state
+static int state;       // Current P-state or C-state
+static int lastP;       // P-state of the last dispatch
+static long since;      // Time the current state was entered or last accounted
+
+// Statistics
+static double busyEnergy, idleEnergy;
+static long pTime[ENERGY_MAX_STATES], cTime[ENERGY_MAX_STATES];
+static int cEntries[ENERGY_MAX_STATES];
+static int wakeups;
+static long wakeLatency;
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// Charges the time since the last change to the current state
+static void flush(long now) {
+    long dt = now - since;
+    if(dt > 0 && idle) {
+        idleEnergy += (double)idlePower[state] * dt;
+        cTime[state] += dt;
+    } else if(dt > 0) {
+        busyEnergy += (double)power[state] * dt;
+        pTime[state] += dt;
+    }
+    since = now;
+}
+
+// ---------------------------------------- Energy functions --------------------------------------
+
+void Energy_reset(long now) {
+    numP = sizeof(defaultSpeed) / sizeof(int);
+    memcpy(speed, defaultSpeed, sizeof(defaultSpeed));
+    memcpy(power, defaultPower, sizeof(defaultPower));
+    numC = sizeof(defaultIdlePower) / sizeof(int);
+    memcpy(idlePower, defaultIdlePower, sizeof(defaultIdlePower));
+    memcpy(latency, defaultLatency, sizeof(defaultLatency));
+    memcpy(residency, defaultResidency, sizeof(defaultResidency));
+    governor = GOV_PERFORMANCE;
+    busyEnergy = idleEnergy = 0;
+    memset(pTime, 0, sizeof(pTime));
+    memset(cTime, 0, sizeof(cTime));
+    memset(cEntries, 0, sizeof(cEntries));
+    wakeups = 0;
+    wakeLatency = 0;
+    lastP = 0;
+    idle = false;
+    since = now;
+    Energy_idle(now, -1);
+}
+
+int Energy_set_pstates(long now, int count, const int* newSpeed, const int* newPower) {
+    if(count < 1 || count > ENERGY_MAX_STATES)
+        return ENERGY_FAIL;
+    for(int i = 0; i < count; i++) {
+        if(newSpeed[i] < 1 || newSpeed[i] > 100 || newPower[i] < 0 || (i > 0 && newSpeed[i] >= newSpeed[i - 1]))
+            return ENERGY_FAIL;
+    }
+    flush(now);
+    numP = count;
+    memcpy(speed, newSpeed, count * sizeof(int));
+    memcpy(power, newPower, count * sizeof(int));
+    if(lastP >= numP)
+        lastP = numP - 1;
+    if(!idle && state >= numP)  // The new table applies to the running process from its next dispatch
+        state = numP - 1;
+    return ENERGY_SUCCESS;
+}
+
+int Energy_set_cstates(long now, int count, const int* newPower, const int* newLatency, const int* newResidency) {
+    if(count < 1 || count > ENERGY_MAX_STATES)
+        return ENERGY_FAIL;
+    for(int i = 0; i < count; i++) {
+        if(newPower[i] < 0 || newLatency[i] < 0 || newResidency[i] < 0)
+            return ENERGY_FAIL;
+        if(i > 0 && (newPower[i] > newPower[i - 1] || newResidency[i] < newResidency[i - 1]))
+            return ENERGY_FAIL;
+    }
+    flush(now);
+    numC = count;
+    memcpy(idlePower, newPower, count * sizeof(int));
+    memcpy(latency, newLatency, count * sizeof(int));
+    memcpy(residency, newResidency, count * sizeof(int));
+    if(idle && state >= numC)
+        state = numC - 1;
+    return ENERGY_SUCCESS;
+}
+
+int Energy_set_governor(int newGovernor) {
+    if(newGovernor < GOV_PERFORMANCE || newGovernor > GOV_ONDEMAND)
+        return ENERGY_FAIL;
+    governor = newGovernor;
+    return ENERGY_SUCCESS;
+}
+
+void Energy_idle(long now, long predicted) {
+    flush(now);
+    int c = 0;
+    while(c + 1 < numC && (predicted < 0 || residency[c + 1] <= predicted))
+        c++;
+    idle = true;
+    state = c;
+    cEntries[c]++;
+}
+
+long Energy_wake(long now) {
+    if(!idle)
+        return 0;
+    flush(now);
+    long exitLatency = latency[state];
+    idle = false;
+    state = lastP;
+    wakeups++;
+    wakeLatency += exitLatency;
+    return exitLatency;
+}
+
+int Energy_run(long now, bool contended) {
+    flush(now);
+    if(governor == GOV_PERFORMANCE)
+        state = 0;
+    else if(governor == GOV_POWERSAVE)
+        state = numP - 1;
+    else
+        state = contended ? 0 : numP - 1;
+    idle = false;
+    lastP = state;
+    return speed[state];
+}
+
+void Energy_print_stats(long now, int completedJobs) {
+    flush(now);
+    double total = busyEnergy + idleEnergy;
+    printf("Energy: %.0f (%.0f busy, %.0f idle)", total, busyEnergy, idleEnergy);
+    if(completedJobs > 0)
+        printf(", %.1f per completed job", total / completedJobs);
+    printf("\n");
+    printf("P-state ticks:");
+    for(int i = 0; i < numP; i++)
+        printf(" P%d(%d%%) %ld", i, speed[i], pTime[i]);
+    printf("\nC-state ticks:");
+    for(int i = 0; i < numC; i++)
+        printf(" C%d %ld (entered %d time(s))", i + 1, cTime[i], cEntries[i]);
+    printf("\nWake-ups from idle: %d, %ld tick(s) of exit latency\n", wakeups, wakeLatency);
+}
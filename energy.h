@@ -0,0 +1,48 @@
+// Energy model header file
+// The simulated core runs at one of up to ENERGY_MAX_STATES performance states (P-states), each
+// with a speed and a power draw, and sleeps in one of up to ENERGY_MAX_STATES idle states
+// (C-states), each with a power draw, an exit latency and a target residency. Energy is the power
+// of the current state times the ticks spent in it
+#ifndef _ENERGY_H_
+#define _ENERGY_H_
+#include <stdbool.h>
+
+#define ENERGY_MAX_STATES 8
+#define ENERGY_SUCCESS 0
+#define ENERGY_FAIL -1
+
+enum energy_governor{
+    GOV_PERFORMANCE,    // Always the fastest P-state, races to idle
+    GOV_POWERSAVE,      // Always the slowest P-state
+    GOV_ONDEMAND        // Fastest while other processes are waiting to run, slowest otherwise
+};
+
+// Restores the default tables and governor, clears the statistics and starts idle at time now
+void Energy_reset(long now);
+
+// Replaces the P-state table, speeds are percentages of the fastest possible speed (1 to 100)
+// given fastest first. Returns ENERGY_SUCCESS or ENERGY_FAIL (bad count, speed or power)
+int Energy_set_pstates(long now, int count, const int* speed, const int* power);
+
+// Replaces the C-state table, shallowest first. Returns ENERGY_SUCCESS or ENERGY_FAIL (bad count,
+// negative value or a state that is not deeper than the one before)
+int Energy_set_cstates(long now, int count, const int* power, const int* latency, const int* residency);
+
+// Returns ENERGY_SUCCESS or ENERGY_FAIL for an unknown governor
+int Energy_set_governor(int governor);
+
+// The core goes idle at time now and expects to stay idle for predicted ticks (-1 = unknown).
+// The deepest C-state whose target residency fits is entered
+void Energy_idle(long now, long predicted);
+
+// Wakes the core at time now, returns the exit latency of the C-state it was in (0 if it was busy)
+long Energy_wake(long now);
+
+// A process is dispatched at time now, contended if others are waiting to run
+// Returns the speed of the P-state the governor picks
+int Energy_run(long now, bool contended);
+
+// Prints the energy used up to time now, per completed job, and the time spent in each state
+void Energy_print_stats(long now, int completedJobs);
+
+#endif
@@ -0,0 +1,139 @@
+#include "event.h"
+#include <stdlib.h>
+
+#define ARITY 4
+
+static Event* heap = NULL;
+static int count = 0;
+static int capacity = 0;
+static long nextSeq = 0;
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static bool earlier(Event* a, Event* b) {
+    return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+
+// Stores ev at index i, keeping its timer pointed at it
+static void place(int i, Event* ev) {
+    heap[i] = *ev;
+    if(ev->timer)
+        ev->timer->index = i;
+}
+
+static void siftUp(int i) {
+    Event ev = heap[i];
+    while(i > 0) {
+        int parent = (i - 1) / ARITY;
+        if(!earlier(&ev, &heap[parent]))
+            break;
+        place(i, &heap[parent]);
+        i = parent;
+    }
+    place(i, &ev);
+}
+
+static void siftDown(int i) {
+    Event ev = heap[i];
+    while(true) {
+        int first = i * ARITY + 1;
+        if(first >= count)
+            break;
+        int best = first;   // Earliest of up to 4 children
+        int last = first + ARITY < count ? first + ARITY : count;
+        for(int c = first + 1; c < last; c++) {
+            if(earlier(&heap[c], &heap[best]))
+                best = c;
+        }
+        if(!earlier(&heap[best], &ev))
+            break;
+        place(i, &heap[best]);
+        i = best;
+    }
+    place(i, &ev);
+}
+
+// Removes the event at index i
+static void removeAt(int i) {
+    if(heap[i].timer)
+        heap[i].timer->index = -1;
+    if(--count == i)
+        return;
+    Event last = heap[count];
+    bool up = earlier(&last, &heap[i]);
+    place(i, &last);
+    if(up)
+        siftUp(i);
+    else
+        siftDown(i);
+}
+
+// ---------------------------------------- Event functions ---------------------------------------
+
+// Schedules an event of the given type at time
+int Event_push(long time, int type, int arg) {
+    return Event_push_timer(time, type, arg, NULL);
+}
+
+// Schedules an event tied to timer
+int Event_push_timer(long time, int type, int arg, Event_timer* timer) {
+    if(timer)
+        Event_cancel(timer);
+    if(count == capacity) {
+        int newCapacity = capacity ? capacity * 2 : 64;
+        Event* grown = realloc(heap, newCapacity * sizeof(Event));
+        if(grown == NULL)
+            return EVENT_FAIL;
+        heap = grown;
+        capacity = newCapacity;
+    }
+    heap[count].time = time;
+    heap[count].seq = nextSeq++;
+    heap[count].type = type;
+    heap[count].arg = arg;
+    heap[count].timer = timer;
+    siftUp(count++);
+    return EVENT_SUCCESS;
+}
+
+// Removes the event tied to timer
+bool Event_cancel(Event_timer* timer) {
+    if(timer->index < 0)
+        return false;
+    removeAt(timer->index);
+    return true;
+}
+
+// Copies the earliest pending event into ev without removing it
+bool Event_peek(Event* ev) {
+    if(count == 0)
+        return false;
+    *ev = heap[0];
+    return true;
+}
+
+// Removes the earliest pending event and copies it into ev
+bool Event_pop(Event* ev) {
+    if(count == 0)
+        return false;
+    *ev = heap[0];
+    removeAt(0);
+    return true;
+}
+
+// Returns the number of pending events
+int Event_count() {
+    return count;
+}
+
+// Drops every pending event and releases the heap
+void Event_clear() {
+    for(int i = 0; i < count; i++) {
+        if(heap[i].timer)
+            heap[i].timer->index = -1;
+    }
+    free(heap);
+    heap = NULL;
+    count = 0;
+    capacity = 0;
+}
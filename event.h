@@ -0,0 +1,62 @@
+// Discrete-event queue header file
+// Pending events are kept in a 4-ary min-heap ordered by time, events with the same time
+// come out in the order they were scheduled. An event tied to a timer can be cancelled in O(log n)
+#ifndef _EVENT_H_
+#define _EVENT_H_
+#include <stdbool.h>
+
+#define EVENT_SUCCESS 0
+#define EVENT_FAIL -1
+
+enum event_type{
+    EV_ARRIVAL,     // New process arrives (arg = priority)
+    EV_QUANTUM,     // Time quantum of the running process expires (arg = dispatch number)
+    EV_FAULT_DONE,  // Page fault serviced (arg = PID)
+    EV_IO_DONE,     // A device may have finished a request
+    EV_BURST_DONE,  // Running process finished its CPU burst (arg = burst generation of the process)
+    EV_SLEEP_DONE,  // Timed I/O burst finished (arg = PID)
+    EV_BOOST,       // Periodic priority boost (arg = boost epoch)
+    EV_REPLENISH,   // Throttled deadline process gets its next reservation (arg = PID)
+    EV_DEADLINE,    // Absolute deadline of a deadline process (arg = PID)
+    EV_PREEMPT,     // Wakeup granularity of the running process has passed (arg = dispatch number)
+    EV_CG_REFILL    // Control group starts a new quota period (arg = refill timer)
+};
+
+// Kept by the owner of an event that may have to be cancelled, the heap keeps index up to date
+typedef struct Event_timer_s Event_timer;
+struct Event_timer_s{
+    int index;  // Place of the event in the heap, -1 while no event is tied to the timer
+};
+#define EVENT_TIMER_INIT {-1}
+
+typedef struct Event_s Event;
+struct Event_s{
+    long time;
+    long seq;   // Scheduling order, breaks ties between events at the same time
+    int type;
+    int arg;
+    Event_timer* timer; // NULL if the event cannot be cancelled
+};
+
+// Schedules an event of the given type at time, returns EVENT_SUCCESS or EVENT_FAIL
+int Event_push(long time, int type, int arg);
+
+// Schedules an event like Event_push and ties it to timer, cancelling the event already tied to it
+int Event_push_timer(long time, int type, int arg, Event_timer* timer);
+
+// Removes the event tied to timer, returns false if it has already been popped or cancelled
+bool Event_cancel(Event_timer* timer);
+
+// Copies the earliest pending event into ev without removing it, returns false if there is none
+bool Event_peek(Event* ev);
+
+// Removes the earliest pending event and copies it into ev, returns false if there is none
+bool Event_pop(Event* ev);
+
+// Returns the number of pending events
+int Event_count();
+
+// Drops every pending event and releases the heap
+void Event_clear();
+
+#endif
@@ -0,0 +1,82 @@
+#include "fairness.h"
+#include <stdio.h>
+
+#define LEVELS FAIR_LEVELS
+
+static int live = 0;            // Live processes counted in the index
+static long double cpuSum = 0;  // Sum of their CPU time
+static long double cpuSquares = 0;  // Sum of the squares of their CPU time
+static long levelCpu[LEVELS];
+static long levelWait[LEVELS];      // Total ready wait of dispatches at each level
+static long levelDispatches[LEVELS];
+static long levelMaxWait[LEVELS];
+static long alarms = 0;
+
+// Clears every statistic
+void Fair_reset() {
+    live = 0;
+    cpuSum = cpuSquares = 0;
+    for(int i = 0; i < LEVELS; i++)
+        levelCpu[i] = levelWait[i] = levelDispatches[i] = levelMaxWait[i] = 0;
+    alarms = 0;
+}
+
+void Fair_join() {
+    live++;
+}
+
+void Fair_leave(long cpu) {
+    live--;
+    cpuSum -= cpu;
+    cpuSquares -= (long double)cpu * cpu;
+}
+
+// A process that had used before ticks ran for ran more
+void Fair_charge(long before, long ran, int level) {
+    long after = before + ran;
+    cpuSum += ran;
+    cpuSquares += (long double)after * after - (long double)before * before;
+    if(level >= 0 && level < LEVELS)
+        levelCpu[level] += ran;
+}
+
+// A process was dispatched after waiting ready for waited ticks
+void Fair_wait(long waited, int level) {
+    if(level < 0 || level >= LEVELS)
+        return;
+    levelWait[level] += waited;
+    levelDispatches[level]++;
+    if(waited > levelMaxWait[level])
+        levelMaxWait[level] = waited;
+}
+
+void Fair_starved() {
+    alarms++;
+}
+
+// Returns Jain's index over the CPU time of live processes
+double Fair_jain() {
+    if(live == 0 || cpuSquares <= 0)
+        return 1.0;
+    return (double)(cpuSum * cpuSum / (live * cpuSquares));
+}
+
+// Prints the fairness statistics
+void Fair_print_stats(const long waiting[FAIR_LEVELS]) {
+    long busy = 0;
+    long longest[LEVELS];
+    for(int i = 0; i < LEVELS; i++) {
+        busy += levelCpu[i];
+        longest[i] = waiting[i] > levelMaxWait[i] ? waiting[i] : levelMaxWait[i];
+    }
+    printf("Fairness: Jain's index %.3f over %d live process(es), %ld starvation alarm(s)\n", Fair_jain(), live, alarms);
+    printf("CPU share (low/medium/high/real-time): %.1f%%/%.1f%%/%.1f%%/%.1f%%\n",
+        busy ? 100.0 * levelCpu[0] / busy : 0.0, busy ? 100.0 * levelCpu[1] / busy : 0.0,
+        busy ? 100.0 * levelCpu[2] / busy : 0.0, busy ? 100.0 * levelCpu[3] / busy : 0.0);
+    printf("Ready wait (low/medium/high/real-time): mean %.1f/%.1f/%.1f/%.1f ticks, longest %ld/%ld/%ld/%ld ticks\n",
+        levelDispatches[0] ? (double)levelWait[0] / levelDispatches[0] : 0.0,
+        levelDispatches[1] ? (double)levelWait[1] / levelDispatches[1] : 0.0,
+        levelDispatches[2] ? (double)levelWait[2] / levelDispatches[2] : 0.0,
+        levelDispatches[3] ? (double)levelWait[3] / levelDispatches[3] : 0.0,
+        longest[0], longest[1], longest[2], longest[3]);
+}
@@ -0,0 +1,37 @@
+// Fairness accounting header file
+// Keeps running sums of the CPU time of live processes, so Jain's fairness index
+// (sum x)^2 / (n * sum x^2) is available at any time, along with each priority level's share of
+// the CPU and how long its processes waited while ready. Every update is O(1)
+#ifndef _FAIRNESS_H_
+#define _FAIRNESS_H_
+
+#define FAIR_LEVELS 4   // The 3 priority levels, low to high, then the deadline and real-time classes
+#define FAIR_REALTIME 3 // Level that deadline and real-time processes are counted at
+
+// Clears every statistic
+void Fair_reset();
+
+// A process entered the system with no CPU time
+void Fair_join();
+
+// A process with cpu ticks of CPU time left the system
+void Fair_leave(long cpu);
+
+// A process at the given level that had used before ticks ran for ran more
+void Fair_charge(long before, long ran, int level);
+
+// A process at the given level was dispatched after waiting ready for waited ticks
+void Fair_wait(long waited, int level);
+
+// A ready process passed the starvation threshold
+void Fair_starved();
+
+// Returns Jain's index over the CPU time of live processes, 1 = perfectly even (or no CPU used yet)
+double Fair_jain();
+
+// Prints the fairness index, CPU share and ready wait of each level and the starvation alarms raised.
+// waiting holds how long the longest waiter still ready at each level has waited so far (-1 if
+// none), so a process that is never dispatched still shows up as the longest wait
+void Fair_print_stats(const long waiting[FAIR_LEVELS]);
+
+#endif
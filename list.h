@@ -25,6 +25,10 @@ enum ListOutOfBounds {
     LIST_OOB_END,
     LIST_OOB_NONE   // Added none to make it easier to check if not out of bounds
 };
+// Called with every item that is added to (added = true) or taken out of a watched list, with the
+// node that holds it. The node of a removed item goes back to the pool once the watcher returns
+typedef void (*WATCH_FN)(void* pItem, Node* pNode, void* pWatchArg, bool added);
+
 typedef struct List_s List;
 struct List_s{
     // TODO: You should change this!
@@ -34,15 +38,20 @@ struct List_s{
     int num_nodes;
     // int num_heads;
     enum ListOutOfBounds status;
+    WATCH_FN watch;     // Watcher of the list's membership, NULL if none
+    void* watchArg;
 };
 
 // Maximum number of unique lists the system can support
 // (You may modify this, but reset the value to 10 when handing in your assignment)
-#define LIST_MAX_NUM_HEADS 10
+#define LIST_MAX_NUM_HEADS 32
 
-// Maximum total number of nodes (statically allocated) to be shared across all lists
+// Number of nodes statically allocated to be shared across all lists
 // (You may modify this, but reset the value to 100 when handing in your assignment)
-#define LIST_MAX_NUM_NODES 100
+#define LIST_MAX_NUM_NODES 1024
+
+// Once the static nodes are used up, nodes are taken from the heap this many at a time
+#define LIST_NODE_CHUNK 1024
 
 // General Error Handling:
 // Client code is assumed never to call these functions with a NULL List pointer, or 
@@ -133,6 +142,40 @@ void List_free(List* pList, FREE_FN pItemFreeFn);
 typedef bool (*COMPARATOR_FN)(void* pItem, void* pComparisonArg);
 void* List_search(List* pList, COMPARATOR_FN pComparator, void* pComparisonArg);
 
+// Bulk operations, nodes are relinked rather than freed and reallocated
+
+// Moves every item of pSrc to the end of pDest. pSrc stays a valid, empty list and
+// pDest's current pointer is unchanged. O(1) between unwatched lists, if either list is watched
+// every item moved is reported, O(n) plus the cost of the watchers.
+void List_splice(List* pDest, List* pSrc);
+
+// Moves the items of pSrc that match the comparator to the end of pDest in a single pass,
+// keeping their order. pDest's current pointer is unchanged, pSrc's is moved before the start
+// if its current item was moved. Returns the number of items moved.
+int List_migrate(List* pDest, List* pSrc, COMPARATOR_FN pComparator, void* pComparisonArg);
+
+// Removes up to max items from the front of pList and stores them in pItems in order.
+// The current pointer is moved before the start. Returns the number of items removed.
+int List_drain(List* pList, void** pItems, int max);
+
+// Returns the current node of pList, a handle that stays valid until its item is removed.
+// Returns NULL if the current pointer is before the start or beyond the end of pList.
+Node* List_curr_node(List* pList);
+
+// Returns the item of pNode and takes it out of pList in O(1). pNode must be in pList.
+// If pNode was the current item the next item becomes the current one.
+void* List_remove_node(List* pList, Node* pNode);
+
+// Makes sure that count more items can be added to lists without running out of nodes,
+// growing the node pool if needed. Returns 0 on success, -1 if the memory could not be allocated.
+int List_reserve(int count);
+
+// Calls pWatchFn whenever an item is added to or taken out of pList, by any of the functions above
+// (NULL = stop watching). Bulk moves between lists report every item moved, once each way,
+// so a splice or migrate involving a watched list walks every item it moves.
+// The watcher is dropped when pList is freed.
+void List_watch(List* pList, WATCH_FN pWatchFn, void* pWatchArg);
+
 // void *printList(List *pList);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,470 @@
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PTE_VALID 0x80000000u   // Page is resident, low bits hold the frame index
+#define PTE_GHOST 0x40000000u   // ARC remembers the page was evicted recently, low bits hold the ghost index
+#define PTE_INDEX 0x3fffffffu
+#define NO_FRAME -1
+
+// Page table entry, lastRef is the time of the last reference plus one (0 = never), kept to
+// 32 bits since only the age within the working set window matters
+struct Mem_pte_s{
+    uint32_t entry;
+    uint32_t lastRef;
+};
+
+// Replacement lists, kept in LRU order. LRU uses T1 only, ARC keeps recently used pages in T1,
+// pages used more than once in T2, and remembers pages evicted from them in the ghost lists B1 and B2
+enum arc_list{
+    ARC_T1, ARC_T2, ARC_B1, ARC_B2, ARC_LISTS
+};
+
+// Physical frame, linked into its replacement list by frame index
+struct Frame_s{
+    Mem_space* owner;   // NULL when the frame is free
+    int vpn;
+    bool referenced;    // CLOCK reference bit
+    int list;           // Replacement list the frame is on
+    int prev;           // Towards least recently used (or next free frame)
+    int next;           // Towards most recently used
+}; typedef struct Frame_s Frame;
+
+// Page ARC evicted recently, it holds no frame
+struct Ghost_s{
+    Mem_space* owner;
+    int vpn;
+    int list;           // ARC_B1 or ARC_B2
+    int prev;
+    int next;           // Also links free ghosts
+}; typedef struct Ghost_s Ghost;
+
+struct Queue_s{
+    int head;   // Least recently used
+    int tail;   // Most recently used
+    int count;
+}; typedef struct Queue_s Queue;
+
+static Frame* frames = NULL;
+static int numFrames = 0;
+static int freeHead = NO_FRAME;     // Singly linked free list through Frame.prev
+static Ghost* ghosts = NULL;        // One per frame, the ghost lists never hold more pages than the cache
+static int ghostFree = NO_FRAME;    // Singly linked free list through Ghost.next
+static Queue queues[ARC_LISTS];
+static int arcTarget = 0;           // ARC: frames T1 aims for, moves towards whichever ghost list gets hits
+static int clockHand = 0;
+static int policy = MEM_LRU;
+static int latency = MEM_DEFAULT_LATENCY;
+static long window = MEM_DEFAULT_WINDOW;
+static long totalFaults = 0;
+static long totalEvictions = 0;
+static long ghostHits = 0;          // ARC misses on pages still in a ghost list
+static long cowSpaces = 0;          // Shared address spaces copied on a write
+static long cowPages = 0;           // Resident pages those copies loaded
+static int usedFrames = 0;
+static Mem_space* spaces = NULL;    // Live address spaces
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// Returns the page table entry for vpn, allocating missing tables if create is true
+static Mem_pte* lookupPTE(Mem_space* space, int vpn, bool create) {
+    int i1 = vpn >> (MEM_L2_BITS + MEM_L3_BITS);
+    int i2 = (vpn >> MEM_L3_BITS) & ((1 << MEM_L2_BITS) - 1);
+    int i3 = vpn & ((1 << MEM_L3_BITS) - 1);
+
+    if(space->root == NULL) {
+        if(!create || !(space->root = calloc(1 << MEM_L1_BITS, sizeof(Mem_pte**))))
+            return NULL;
+        space->tableBytes += (1 << MEM_L1_BITS) * sizeof(Mem_pte**);
+    }
+    if(space->root[i1] == NULL) {
+        if(!create || !(space->root[i1] = calloc(1 << MEM_L2_BITS, sizeof(Mem_pte*))))
+            return NULL;
+        space->tableBytes += (1 << MEM_L2_BITS) * sizeof(Mem_pte*);
+    }
+    if(space->root[i1][i2] == NULL) {
+        if(!create || !(space->root[i1][i2] = calloc(1 << MEM_L3_BITS, sizeof(Mem_pte))))
+            return NULL;
+        space->tableBytes += (1 << MEM_L3_BITS) * sizeof(Mem_pte);
+    }
+    return &space->root[i1][i2][i3];
+}
+
+// Returns the prev or next link of item i of a replacement list, frames for T1/T2 and ghosts for B1/B2
+static int* listLink(int list, int i, bool next) {
+    if(list == ARC_T1 || list == ARC_T2)
+        return next ? &frames[i].next : &frames[i].prev;
+    return next ? &ghosts[i].next : &ghosts[i].prev;
+}
+
+static void listUnlink(int list, int i) {
+    Queue* q = &queues[list];
+    int prev = *listLink(list, i, false);
+    int next = *listLink(list, i, true);
+    if(prev != NO_FRAME)
+        *listLink(list, prev, true) = next;
+    else
+        q->head = next;
+    if(next != NO_FRAME)
+        *listLink(list, next, false) = prev;
+    else
+        q->tail = prev;
+    q->count--;
+}
+
+static void listPushTail(int list, int i) {    // Mark item as most recently used
+    Queue* q = &queues[list];
+    *listLink(list, i, false) = q->tail;
+    *listLink(list, i, true) = NO_FRAME;
+    if(q->tail != NO_FRAME)
+        *listLink(list, q->tail, true) = i;
+    else
+        q->head = i;
+    q->tail = i;
+    q->count++;
+}
+
+// Forgets ghost g, clearing the page table entry that points at it
+static void dropGhost(int g) {
+    Mem_pte* pte = lookupPTE(ghosts[g].owner, ghosts[g].vpn, false);
+    if(pte && pte->entry == (PTE_GHOST | g))
+        pte->entry = 0;
+    listUnlink(ghosts[g].list, g);
+    ghosts[g].owner = NULL;
+    ghosts[g].next = ghostFree;
+    ghostFree = g;
+}
+
+// Remembers the page held in frame f on a ghost list, dropping the oldest ghost if none are free
+static void addGhost(int f, int list, Mem_pte* pte) {
+    if(ghostFree == NO_FRAME)
+        dropGhost(queues[ARC_B1].count >= queues[ARC_B2].count ? queues[ARC_B1].head : queues[ARC_B2].head);
+    int g = ghostFree;
+    ghostFree = ghosts[g].next;
+    ghosts[g].owner = frames[f].owner;
+    ghosts[g].vpn = frames[f].vpn;
+    ghosts[g].list = list;
+    listPushTail(list, g);
+    pte->entry = PTE_GHOST | g;
+}
+
+// Unmaps the page held in frame f from its owner and returns the frame to the free list
+// ARC keeps evicted pages on the ghost list matching the list the frame was on
+static void releaseFrame(int f, bool evicted) {
+    Mem_space* owner = frames[f].owner;
+    Mem_pte* pte = lookupPTE(owner, frames[f].vpn, false);
+    if(policy != MEM_CLOCK)
+        listUnlink(frames[f].list, f);
+    if(pte && evicted && policy == MEM_ARC)
+        addGhost(f, frames[f].list == ARC_T1 ? ARC_B1 : ARC_B2, pte);
+    else if(pte)
+        pte->entry = 0;
+    owner->resident--;
+    usedFrames--;
+    frames[f].owner = NULL;
+    frames[f].prev = freeHead;
+    freeHead = f;
+}
+
+// ARC: adapts the target size of T1 on a miss of the page behind pte, and keeps the directory
+// within its bounds. Returns the list the page joins, *inB2 is set if it was a B2 ghost
+static int arcMiss(Mem_pte* pte, bool* inB2) {
+    int b1 = queues[ARC_B1].count, b2 = queues[ARC_B2].count;
+    if(pte->entry & PTE_GHOST) {    // Evicted too soon, grow the side it was evicted from
+        int g = pte->entry & PTE_INDEX;
+        ghostHits++;
+        if(ghosts[g].list == ARC_B1) {
+            arcTarget += b2 > b1 ? b2 / b1 : 1;
+            if(arcTarget > numFrames)
+                arcTarget = numFrames;
+        } else {
+            arcTarget -= b1 > b2 ? b1 / b2 : 1;
+            if(arcTarget < 0)
+                arcTarget = 0;
+            *inB2 = true;
+        }
+        dropGhost(g);
+        return ARC_T2;  // Seen twice
+    }
+    // New page: T1 and B1 together hold at most the cache size, all four lists at most twice it
+    int t1 = queues[ARC_T1].count, t2 = queues[ARC_T2].count;
+    if(t1 + b1 >= numFrames && b1 > 0)
+        dropGhost(queues[ARC_B1].head);
+    else if(t1 + b1 < numFrames && t1 + t2 + b1 + b2 >= 2 * numFrames && b2 > 0)
+        dropGhost(queues[ARC_B2].head);
+    return ARC_T1;
+}
+
+// Picks a resident frame to evict according to the replacement policy
+static int pickVictim(bool inB2) {
+    if(policy == MEM_LRU)
+        return queues[ARC_T1].head;
+    if(policy == MEM_ARC) {     // Evict from T1 while it is over its target
+        int t1 = queues[ARC_T1].count;
+        bool fromT1 = t1 > 0 && (t1 > arcTarget || (inB2 && t1 == arcTarget) || queues[ARC_T2].count == 0);
+        return fromT1 ? queues[ARC_T1].head : queues[ARC_T2].head;
+    }
+    // CLOCK: give referenced frames a second chance
+    while(frames[clockHand].referenced) {
+        frames[clockHand].referenced = false;
+        clockHand = (clockHand + 1) % numFrames;
+    }
+    int victim = clockHand;
+    clockHand = (clockHand + 1) % numFrames;
+    return victim;
+}
+
+// Loads page vpn of space into a frame, taking a free one or evicting one, and maps it in pte
+static void loadPage(Mem_space* space, int vpn, Mem_pte* pte) {
+    bool inB2 = false;
+    int list = policy == MEM_ARC ? arcMiss(pte, &inB2) : ARC_T1;
+    int f = freeHead;
+    if(f != NO_FRAME)
+        freeHead = frames[f].prev;
+    else {
+        f = pickVictim(inB2);
+        releaseFrame(f, true);
+        freeHead = frames[f].prev;  // releaseFrame() pushed it on the free list
+        totalEvictions++;
+    }
+    frames[f].owner = space;
+    frames[f].vpn = vpn;
+    frames[f].referenced = true;
+    frames[f].list = list;
+    if(policy != MEM_CLOCK)
+        listPushTail(list, f);
+    pte->entry = PTE_VALID | f;
+    space->resident++;
+    usedFrames++;
+}
+
+// ---------------------------------------- Memory functions --------------------------------------
+
+// Sets the size of the frame pool, the replacement policy and the page fault latency (in ticks)
+int Mem_configure(int count, int newPolicy, int newLatency) {
+    if(count <= 0 || count > (int)PTE_INDEX || newLatency < 0 || newPolicy < MEM_LRU || newPolicy > MEM_ARC)
+        return -1;
+    Frame* newFrames = malloc(count * sizeof(Frame));
+    Ghost* newGhosts = malloc(count * sizeof(Ghost));
+    if(newFrames == NULL || newGhosts == NULL) {
+        free(newFrames);
+        free(newGhosts);
+        return -1;
+    }
+
+    for(int f = 0; f < numFrames; f++) {   // Evict everything from the old pool
+        if(frames[f].owner)
+            releaseFrame(f, false);
+    }
+    for(int g = 0; g < numFrames; g++) {
+        if(ghosts[g].owner)
+            dropGhost(g);
+    }
+    free(frames);
+    free(ghosts);
+
+    frames = newFrames;
+    ghosts = newGhosts;
+    numFrames = count;
+    for(int f = 0; f < numFrames; f++) {
+        frames[f].owner = NULL;
+        frames[f].referenced = false;
+        frames[f].next = NO_FRAME;
+        frames[f].prev = f + 1 < numFrames ? f + 1 : NO_FRAME;
+        ghosts[f].owner = NULL;
+        ghosts[f].next = f + 1 < numFrames ? f + 1 : NO_FRAME;
+    }
+    freeHead = 0;
+    ghostFree = 0;
+    for(int i = 0; i < ARC_LISTS; i++)
+        queues[i] = (Queue){NO_FRAME, NO_FRAME, 0};
+    arcTarget = 0;
+    clockHand = 0;
+    policy = newPolicy;
+    latency = newLatency;
+    return 0;
+}
+
+// Returns the page fault latency in ticks
+int Mem_latency() {
+    return latency;
+}
+
+int Mem_set_window(long newWindow) {
+    if(newWindow < 1 || newWindow > (long)PTE_INDEX)
+        return -1;
+    window = newWindow;
+    return 0;
+}
+
+// Creates an empty address space, returns NULL if failed
+Mem_space* Mem_space_create() {
+    if(frames == NULL && Mem_configure(MEM_DEFAULT_FRAMES, MEM_LRU, MEM_DEFAULT_LATENCY) != 0)
+        return NULL;
+    Mem_space* space = calloc(1, sizeof(Mem_space));
+    if(space == NULL)
+        return NULL;
+    space->refCount = 1;
+    space->next = spaces;
+    if(spaces)
+        spaces->prev = space;
+    spaces = space;
+    return space;
+}
+
+// Adds a sharer to space
+Mem_space* Mem_space_share(Mem_space* space) {
+    if(space != NULL)
+        space->refCount++;
+    return space;
+}
+
+// Drops a sharer of space, the last one releases every frame and ghost held by space and frees its page tables
+void Mem_space_free(Mem_space* space) {
+    if(space == NULL || --space->refCount > 0)
+        return;
+    if(space->root) {
+        for(int i1 = 0; i1 < (1 << MEM_L1_BITS); i1++) {
+            if(!space->root[i1])
+                continue;
+            for(int i2 = 0; i2 < (1 << MEM_L2_BITS); i2++) {
+                Mem_pte* leaf = space->root[i1][i2];
+                if(!leaf)
+                    continue;
+                for(int i3 = 0; i3 < (1 << MEM_L3_BITS); i3++) {
+                    if(leaf[i3].entry & PTE_VALID)
+                        releaseFrame(leaf[i3].entry & PTE_INDEX, false);
+                    else if(leaf[i3].entry & PTE_GHOST)
+                        dropGhost(leaf[i3].entry & PTE_INDEX);
+                }
+                free(leaf);
+            }
+            free(space->root[i1]);
+        }
+        free(space->root);
+    }
+    if(space->prev)
+        space->prev->next = space->next;
+    else
+        spaces = space->next;
+    if(space->next)
+        space->next->prev = space->prev;
+    free(space);
+}
+
+// Returns space for writing, copying its page tables and resident pages first if it is shared
+Mem_space* Mem_space_write(Mem_space* space) {
+    if(space->refCount == 1)
+        return space;
+    Mem_space* copy = Mem_space_create();
+    if(copy == NULL)
+        return NULL;
+    for(int i1 = 0; space->root && i1 < (1 << MEM_L1_BITS); i1++) {
+        if(!space->root[i1])
+            continue;
+        for(int i2 = 0; i2 < (1 << MEM_L2_BITS); i2++) {
+            Mem_pte* leaf = space->root[i1][i2];
+            if(!leaf)
+                continue;
+            for(int i3 = 0; i3 < (1 << MEM_L3_BITS); i3++) {
+                if(leaf[i3].lastRef == 0 && !(leaf[i3].entry & PTE_VALID))
+                    continue;   // Never referenced
+                int vpn = (i1 << (MEM_L2_BITS + MEM_L3_BITS)) | (i2 << MEM_L3_BITS) | i3;
+                Mem_pte* pte = lookupPTE(copy, vpn, true);
+                if(pte == NULL) {
+                    Mem_space_free(copy);
+                    return NULL;
+                }
+                pte->lastRef = leaf[i3].lastRef;    // The copy keeps the working set
+                if(leaf[i3].entry & PTE_VALID) {    // Checked as it is reached, loading can evict later pages
+                    loadPage(copy, vpn, pte);
+                    cowPages++;
+                }
+            }
+        }
+    }
+    space->refCount--;
+    cowSpaces++;
+    return copy;
+}
+
+// Returns the bytes of bookkeeping behind space
+int Mem_space_bytes(Mem_space* space) {
+    return sizeof(Mem_space) + space->tableBytes;
+}
+
+// Touches virtual page vpn of space at time now, loading it into a frame on a fault
+int Mem_access(Mem_space* space, int vpn, long now) {
+    if(vpn < 0 || vpn > MEM_MAX_VPN)
+        return MEM_FAIL;
+    Mem_pte* pte = lookupPTE(space, vpn, true);
+    if(pte == NULL)
+        return MEM_FAIL;
+    pte->lastRef = (uint32_t)(now + 1);
+
+    if(pte->entry & PTE_VALID) {    // Hit, update recency
+        int f = pte->entry & PTE_INDEX;
+        if(policy == MEM_LRU) {
+            listUnlink(ARC_T1, f);
+            listPushTail(ARC_T1, f);
+        } else if(policy == MEM_ARC) {  // Used again, so it is frequent
+            listUnlink(frames[f].list, f);
+            frames[f].list = ARC_T2;
+            listPushTail(ARC_T2, f);
+        } else
+            frames[f].referenced = true;
+        return MEM_HIT;
+    }
+
+    loadPage(space, vpn, pte);  // Fault
+    space->faults++;
+    totalFaults++;
+    return MEM_FAULT;
+}
+
+// Returns the number of distinct pages space referenced in the working set window before now
+int Mem_working_set(Mem_space* space, long now) {
+    int pages = 0;
+    uint32_t stamp = (uint32_t)(now + 1);
+    if(space->root == NULL)
+        return 0;
+    for(int i1 = 0; i1 < (1 << MEM_L1_BITS); i1++) {
+        if(!space->root[i1])
+            continue;
+        for(int i2 = 0; i2 < (1 << MEM_L2_BITS); i2++) {
+            Mem_pte* leaf = space->root[i1][i2];
+            if(!leaf)
+                continue;
+            for(int i3 = 0; i3 < (1 << MEM_L3_BITS); i3++) {
+                if(leaf[i3].lastRef != 0 && stamp - leaf[i3].lastRef < (uint32_t)window)
+                    pages++;
+            }
+        }
+    }
+    return pages;
+}
+
+// Prints the frame pool configuration, global fault/eviction counts and the working set total
+void Mem_print_stats(long now) {
+    const char* names[] = {"LRU", "CLOCK", "ARC"};
+    printf("Frames: %d/%d in use, policy %s, fault latency %d ticks\n", usedFrames, numFrames,
+        names[policy], latency);
+    printf("Page faults: %ld, evictions: %ld\n", totalFaults, totalEvictions);
+    if(policy == MEM_ARC)
+        printf("ARC: target %d recent frame(s), recent/frequent %d/%d, ghosts %d/%d, %ld ghost hit(s)\n",
+            arcTarget, queues[ARC_T1].count, queues[ARC_T2].count, queues[ARC_B1].count, queues[ARC_B2].count,
+            ghostHits);
+    if(cowSpaces > 0)
+        printf("Copy-on-write: %ld shared address space(s) copied on a write, %ld resident page(s) copied\n",
+            cowSpaces, cowPages);
+    int count = 0;
+    long pages = 0;
+    for(Mem_space* space = spaces; space != NULL; space = space->next) {
+        count++;
+        pages += Mem_working_set(space, now);
+    }
+    if(count > 0)
+        printf("Working sets: %ld page(s) over %d address space(s) in the last %ld ticks%s\n", pages, count,
+            window, pages > numFrames ? ", more than fit in memory (thrashing)" : "");
+}
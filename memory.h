@@ -0,0 +1,84 @@
+// Simulated memory manager header file
+// Each process owns an address space with a radix page table, physical frames come from
+// one global pool shared by every process. The page tables also record when each page was last
+// referenced, which gives every address space's working set: the distinct pages it referenced in
+// the last window ticks, resident or not. A forked process shares its parent's address space
+// until one of them writes to it, the writer then takes a private copy
+#ifndef _MEMORY_H_
+#define _MEMORY_H_
+#include <stdbool.h>
+#include <stdint.h>
+
+// Virtual page numbers are 20 bits, split 6/7/7 over a 3 level radix page table so that a
+// process touching a handful of pages only needs a few small tables
+#define MEM_VPN_BITS 20
+#define MEM_L1_BITS 6
+#define MEM_L2_BITS 7
+#define MEM_L3_BITS 7
+#define MEM_MAX_VPN ((1 << MEM_VPN_BITS) - 1)
+
+#define MEM_DEFAULT_FRAMES 64
+#define MEM_DEFAULT_LATENCY 2   // Ticks a faulting process stays blocked
+#define MEM_DEFAULT_WINDOW 20   // Working set window in ticks
+
+#define MEM_HIT 0
+#define MEM_FAULT 1
+#define MEM_FAIL -1
+
+enum mem_policy{    // Page replacement policies
+    MEM_LRU, MEM_CLOCK,
+    MEM_ARC     // Adaptive replacement cache, balances recently and frequently used pages using ghost lists
+};
+
+typedef struct Mem_pte_s Mem_pte;
+typedef struct Mem_space_s Mem_space;
+struct Mem_space_s{
+    Mem_pte*** root;    // Level 1 table, allocated on first access
+    int resident;   // Pages currently in a frame
+    int faults;     // Page faults taken by this address space
+    int tableBytes; // Memory used by the page tables (all levels)
+    int refCount;   // Processes sharing the space, copied on the first write of one of them
+    Mem_space* prev;    // Every live address space is linked for the working set totals
+    Mem_space* next;
+};
+
+// Sets the size of the frame pool, the replacement policy and the page fault latency (in ticks)
+// All resident pages are evicted. Returns 0 on success, -1 on failure
+int Mem_configure(int frames, int policy, int latency);
+
+// Returns the page fault latency in ticks
+int Mem_latency();
+
+// Sets the working set window in ticks (at least 1), returns 0 on success, -1 on failure
+int Mem_set_window(long window);
+
+// Creates an empty address space, returns NULL if failed
+Mem_space* Mem_space_create();
+
+// Adds a sharer to space (NULL is shared as NULL), returns space
+Mem_space* Mem_space_share(Mem_space* space);
+
+// Drops a sharer of space, the last one releases every frame held by space and frees its page tables
+void Mem_space_free(Mem_space* space);
+
+// Returns space for writing, copying it first if it is shared: the copy gets the page tables and a
+// frame of its own for every resident page, evicting others if needed. The caller's share of space
+// moves to the copy. Returns NULL if the copy could not be allocated
+Mem_space* Mem_space_write(Mem_space* space);
+
+// Returns the bytes of bookkeeping behind space, the space itself and its page tables
+int Mem_space_bytes(Mem_space* space);
+
+// Touches virtual page vpn of space at time now, loading it into a frame (evicting one if needed) on a fault
+// A write must go through Mem_space_write() first
+// Returns MEM_HIT, MEM_FAULT or MEM_FAIL (invalid page or no memory for page tables)
+int Mem_access(Mem_space* space, int vpn, long now);
+
+// Returns the number of distinct pages space referenced in the working set window before now
+int Mem_working_set(Mem_space* space, long now);
+
+// Prints the frame pool configuration, global fault/eviction counts and the working sets of all
+// address spaces at time now against the number of frames
+void Mem_print_stats(long now);
+
+#endif
@@ -0,0 +1,35 @@
+#include "random.h"
+#include <math.h>
+
+static unsigned long seed = RANDOM_DEFAULT_SEED;
+static unsigned long state = RANDOM_DEFAULT_SEED;
+
+// Seeds the generator (0 selects the default seed)
+void Random_seed(unsigned long newSeed) {
+    seed = newSeed ? newSeed : RANDOM_DEFAULT_SEED;
+    state = seed;
+}
+
+// Returns the seed the generator was last seeded with
+unsigned long Random_get_seed() {
+    return seed;
+}
+
+// Returns the next 64 bit random number (xorshift64)
+unsigned long Random_next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Returns a random number in [0, 1)
+double Random_uniform() {
+    return (Random_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Returns an exponentially distributed duration with the given mean, rounded up to at least 1
+long Random_exponential(double mean) {
+    long t = (long)ceil(-log(1.0 - Random_uniform()) * mean);
+    return t < 1 ? 1 : t;
+}
@@ -0,0 +1,24 @@
+// Random number generator header file
+// Every random choice in the simulator goes through this generator so that a run is reproducible
+// from its seed
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+#define RANDOM_DEFAULT_SEED 88172645463325252UL
+
+// Seeds the generator (0 selects the default seed)
+void Random_seed(unsigned long seed);
+
+// Returns the seed the generator was last seeded with
+unsigned long Random_get_seed();
+
+// Returns the next 64 bit random number
+unsigned long Random_next();
+
+// Returns a random number in [0, 1)
+double Random_uniform();
+
+// Returns an exponentially distributed duration with the given mean, rounded up to at least 1
+long Random_exponential(double mean);
+
+#endif
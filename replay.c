@@ -0,0 +1,158 @@
+#include "replay.h"
+#include <stdio.h>
+#include <string.h>
+
+// Log format: a header ("OSRR", version byte, 8 byte seed) followed by records. Every record is a
+// tag byte and unsigned LEB128 varints, so a dispatch usually costs 3 bytes:
+//   REC_INPUT     length, bytes of the token
+//   REC_DISPATCH  ticks since the previous dispatch, PID
+#define REPLAY_MAGIC "OSRR"
+#define REPLAY_VERSION 1
+#define REC_INPUT 'i'
+#define REC_DISPATCH 'd'
+
+static int mode = REPLAY_OFF;
+static FILE* logFile = NULL;
+static long lastTime = 0;   // Time of the previous dispatch, dispatch times are delta encoded
+static long position = 0;
+static int pending = EOF;   // Tag of the next record when replaying, read ahead
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static void writeVarint(unsigned long value) {
+    while(value >= 0x80) {
+        fputc((int)(value & 0x7f) | 0x80, logFile);
+        value >>= 7;
+    }
+    fputc((int)value, logFile);
+}
+
+// Returns false on a truncated log
+static bool readVarint(unsigned long* value) {
+    *value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(logFile);
+        if(c == EOF)
+            return false;
+        *value |= (unsigned long)(c & 0x7f) << shift;
+        if(!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// -------------------------------------- Record/replay functions ---------------------------------
+
+// Starts recording to the log at path
+int Replay_record(const char* path, unsigned long seed) {
+    logFile = fopen(path, "wb");
+    if(logFile == NULL)
+        return REPLAY_FAIL;
+    fwrite(REPLAY_MAGIC, 1, 4, logFile);
+    fputc(REPLAY_VERSION, logFile);
+    for(int i = 0; i < 8; i++)
+        fputc((int)(seed >> (8 * i)) & 0xff, logFile);
+    mode = REPLAY_RECORD;
+    return REPLAY_SUCCESS;
+}
+
+// Starts replaying the log at path
+int Replay_replay(const char* path, unsigned long* seed) {
+    char magic[4];
+    logFile = fopen(path, "rb");
+    if(logFile == NULL)
+        return REPLAY_FAIL;
+    if(fread(magic, 1, 4, logFile) != 4 || memcmp(magic, REPLAY_MAGIC, 4) != 0 || fgetc(logFile) != REPLAY_VERSION) {
+        fclose(logFile);
+        logFile = NULL;
+        return REPLAY_FAIL;
+    }
+    *seed = 0;
+    for(int i = 0; i < 8; i++)
+        *seed |= (unsigned long)(fgetc(logFile) & 0xff) << (8 * i);
+    pending = fgetc(logFile);
+    mode = REPLAY_REPLAY;
+    return REPLAY_SUCCESS;
+}
+
+// Returns the current mode
+int Replay_mode() {
+    return mode;
+}
+
+// Appends an input token to the log
+void Replay_log_input(const char* token) {
+    if(mode != REPLAY_RECORD)
+        return;
+    size_t length = strlen(token);
+    fputc(REC_INPUT, logFile);
+    writeVarint(length);
+    fwrite(token, 1, length, logFile);
+    position++;
+}
+
+// Copies the next recorded input token into buf
+int Replay_next_input(char* buf, int size) {
+    unsigned long length;
+    if(pending == REC_DISPATCH)
+        return REPLAY_DIVERGED;
+    if(pending != REC_INPUT || !readVarint(&length))
+        return REPLAY_FAIL;
+    for(unsigned long i = 0; i < length; i++) {
+        int c = fgetc(logFile);
+        if(c == EOF)
+            return REPLAY_FAIL;
+        if(i + 1 < (unsigned long)size)
+            buf[i] = (char)c;
+    }
+    buf[length + 1 < (unsigned long)size ? length : (unsigned long)size - 1] = '\0';
+    pending = fgetc(logFile);
+    position++;
+    return REPLAY_SUCCESS;
+}
+
+// Logs or checks that process pid was dispatched at time
+int Replay_dispatch(long time, int pid, long* recTime, int* recPid) {
+    if(mode == REPLAY_RECORD) {
+        fputc(REC_DISPATCH, logFile);
+        writeVarint(time - lastTime);
+        writeVarint(pid);
+        lastTime = time;
+        position++;
+        return REPLAY_SUCCESS;
+    }
+    if(mode != REPLAY_REPLAY)
+        return REPLAY_SUCCESS;
+
+    unsigned long delta, recordedPid;
+    *recTime = -1;
+    *recPid = -1;
+    if(pending != REC_DISPATCH || !readVarint(&delta) || !readVarint(&recordedPid))
+        return REPLAY_DIVERGED;
+    *recTime = lastTime + (long)delta;
+    *recPid = (int)recordedPid;
+    pending = fgetc(logFile);
+    if(*recTime != time || *recPid != pid)
+        return REPLAY_DIVERGED;
+    lastTime = time;
+    position++;
+    return REPLAY_SUCCESS;
+}
+
+// Returns the number of records written or checked so far
+long Replay_position() {
+    return position;
+}
+
+// Flushes and closes the log
+int Replay_close() {
+    int result = REPLAY_SUCCESS;
+    if(logFile == NULL)
+        return result;
+    if(mode == REPLAY_REPLAY && pending != EOF)
+        result = REPLAY_DIVERGED;
+    fclose(logFile);
+    logFile = NULL;
+    mode = REPLAY_OFF;
+    return result;
+}
@@ -0,0 +1,48 @@
+// Record/replay header file
+// A record log holds every input the simulator consumed and every scheduling decision it made,
+// replaying the log feeds the same inputs back and checks each decision against the recording
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+#include <stdbool.h>
+
+#define REPLAY_SUCCESS 0
+#define REPLAY_FAIL -1      // Log could not be opened/written, or the log has run out
+#define REPLAY_DIVERGED -2  // Run no longer matches the recording
+
+enum replay_mode{
+    REPLAY_OFF, REPLAY_RECORD, REPLAY_REPLAY
+};
+
+// Starts recording to the log at path, seed is the random seed the run starts with
+// Returns REPLAY_SUCCESS or REPLAY_FAIL
+int Replay_record(const char* path, unsigned long seed);
+
+// Starts replaying the log at path, the seed the recording started with is stored in seed
+// Returns REPLAY_SUCCESS or REPLAY_FAIL (missing file, not a record log)
+int Replay_replay(const char* path, unsigned long* seed);
+
+// Returns the current mode
+int Replay_mode();
+
+// Record mode: appends an input token to the log
+void Replay_log_input(const char* token);
+
+// Replay mode: copies the next recorded input token into buf (at most size - 1 characters)
+// Returns REPLAY_SUCCESS, REPLAY_FAIL at the end of the log or REPLAY_DIVERGED if the recording
+// made a scheduling decision first
+int Replay_next_input(char* buf, int size);
+
+// Record mode: logs that process pid was dispatched at time
+// Replay mode: checks the decision against the recording, on a mismatch the recorded decision is
+// stored in recTime/recPid (-1 if the recording had an input there instead)
+// Returns REPLAY_SUCCESS or REPLAY_DIVERGED
+int Replay_dispatch(long time, int pid, long* recTime, int* recPid);
+
+// Returns the number of records written or checked so far
+long Replay_position();
+
+// Flushes and closes the log
+// Returns REPLAY_DIVERGED if a replay stopped before the end of the recording, else REPLAY_SUCCESS
+int Replay_close();
+
+#endif
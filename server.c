@@ -0,0 +1,312 @@
+#define _GNU_SOURCE    // accept4()
+#include "server.h"
+#include "commands.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+
+#define SRV_INPUT (64 * 1024)   // Read buffer, holds many whole requests
+
+struct Client_s{
+    int fd;             // -1 if the slot is free
+    bool events;        // Subscribed to scheduling events
+    bool writable;      // Waiting for EPOLLOUT
+    char in[SRV_INPUT];
+    int inLength;
+    char* out;          // Frames not yet written
+    int outStart;
+    int outLength;
+    int outCapacity;
+}; typedef struct Client_s Client;
+
+static Client* clients[SRV_MAX_CLIENTS];
+static int epollFd = -1;
+static bool serving = false;
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static void closeClient(Client* client) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    client->fd = -1;
+    free(client->out);
+    client->out = NULL;
+    client->events = false;
+}
+
+// Queues a frame on the client, dropping clients that let too much output pile up
+static void queueFrame(Client* client, Srv_frame* frame) {
+    if(client->fd < 0)
+        return;
+    if(client->outStart + client->outLength + (int)sizeof(Srv_frame) > client->outCapacity) {
+        if(client->outStart > 0) {  // Reuse the space of frames already written
+            memmove(client->out, client->out + client->outStart, client->outLength);
+            client->outStart = 0;
+        }
+        if(client->outLength + (int)sizeof(Srv_frame) > client->outCapacity) {
+            if(client->outLength >= SRV_MAX_OUTPUT) {
+                printf("Error: Client on descriptor %d stopped reading, disconnected\n", client->fd);
+                closeClient(client);
+                return;
+            }
+            int capacity = client->outCapacity ? client->outCapacity * 2 : 4096;
+            char* out = realloc(client->out, capacity);
+            if(out == NULL) {
+                closeClient(client);
+                return;
+            }
+            client->out = out;
+            client->outCapacity = capacity;
+        }
+    }
+    memcpy(client->out + client->outStart + client->outLength, frame, sizeof(Srv_frame));
+    client->outLength += sizeof(Srv_frame);
+}
+
+// Writes as much pending output as the socket takes, waiting for EPOLLOUT for the rest
+static void flushClient(Client* client) {
+    while(client->fd >= 0 && client->outLength > 0) {
+        ssize_t n = write(client->fd, client->out + client->outStart, client->outLength);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+                closeClient(client);
+            break;
+        }
+        client->outStart += n;
+        client->outLength -= n;
+    }
+    if(client->fd < 0)
+        return;
+    if(client->outLength == 0)
+        client->outStart = 0;
+    bool writable = client->outLength > 0;
+    if(writable != client->writable) {
+        struct epoll_event ev = {.events = EPOLLIN | EPOLLRDHUP | (writable ? EPOLLOUT : 0), .data.ptr = client};
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client->fd, &ev);
+        client->writable = writable;
+    }
+}
+
+// Event callback of the simulation, streams the event to every subscribed client
+static void streamEvent(enum sched_event event, int pid, long time, void* context) {
+    Srv_frame frame = {SRV_FRAME_EVENT, (uint8_t)event, 0, pid, time};
+    for(int i = 0; i < SRV_MAX_CLIENTS; i++) {
+        if(clients[i] && clients[i]->fd >= 0 && clients[i]->events)
+            queueFrame(clients[i], &frame);
+    }
+}
+
+// Runs one request, returns the value of its reply
+static long execute(Client* client, Srv_request* req, char* payload) {
+    char* second = payload + strlen(payload) + 1;   // Message after the name, empty if there is none
+    if(second > payload + req->length)
+        second = payload + req->length;
+    char msg[MAX_MSG];
+    strncpy(msg, req->op == SRV_SEND || req->op == SRV_REPLY ? payload : second, MAX_MSG - 1);
+    msg[MAX_MSG - 1] = '\0';
+    int a = req->arg[0];
+    int b = req->arg[1];
+    switch(req->op) {
+        case SRV_CREATE:
+            if(a < LOW || a > HIGH)
+                return SCHED_FAIL;
+            return Create(a);
+        case SRV_FORK:              return Fork();
+        case SRV_KILL:              return Kill(a);
+        case SRV_EXIT:              return Exit();
+        case SRV_QUANTUM:           return Quantum();
+        case SRV_SEND:              return Send(a, msg);
+        case SRV_RECEIVE:           return Receive();
+        case SRV_REPLY:             return Reply(a, msg);
+        case SRV_NEW_SEM:           return New_sem(a, b);
+        case SRV_SEM_P:             return Sem_P(a, b);
+        case SRV_SEM_V:             return Sem_V(a);
+        case SRV_SEM_V_N:           return Sem_V_n(a, b);
+        case SRV_WAIT:              return Wait();
+        case SRV_KILL_GROUP:        return Kill_group(a);
+        case SRV_SUSPEND_GROUP:     return Suspend_group(a);
+        case SRV_RESUME_GROUP:      return Resume_group(a);
+        case SRV_PRIORITY_GROUP:
+            if(b < LOW || b > HIGH)
+                return SCHED_FAIL;
+            return Priority_group(a, b);
+        case SRV_ACCESS:            return Access(a, b != 0);
+        case SRV_DEVICE_IO:         return Device_io(a, b);
+        case SRV_ARRIVAL:           return Arrival(a, b);
+        case SRV_RUN:               return Run(a);
+        case SRV_BOOST:             return Boost();
+        case SRV_QUANTUM_LENGTH:    return Configure_quantum(a, b);
+        case SRV_BOOST_PERIOD:      return Configure_boost(a);
+        case SRV_SEM_ORDER:         return Configure_sem_order(a, b);
+        case SRV_CHAN_OPEN:         return Chan_create(payload, a);
+        case SRV_CHAN_SEND:         return Chan_send(payload, msg);
+        case SRV_CHAN_RECEIVE:      return Chan_receive(payload);
+        case SRV_TOPIC_OPEN:        return Topic_create(payload);
+        case SRV_TOPIC_JOIN:        return Topic_join(payload, a != 0);
+        case SRV_TOPIC_PUBLISH:     return Topic_send(payload, msg);
+        case SRV_TOPIC_RECEIVE:     return Topic_recv(payload);
+        case SRV_EVENTS:
+            client->events = a != 0;
+            return SCHED_SUCCESS;
+        case SRV_TIME:              return Sched_time();
+        case SRV_CURRENT:           return Sched_current();
+        case SRV_STARVATION:        return Configure_starvation(a);
+        case SRV_CREATE_RT:         return Create_rt(a, b);
+        case SRV_PREEMPTION:        return Configure_preemption(a != 0, b);
+        case SRV_CGROUP_CREATE:     return Cgroup_create(payload, msg, a);
+        case SRV_CGROUP_LIMIT:      return Cgroup_limit(payload, a, b);
+        case SRV_CGROUP_ATTACH:     return Cgroup_attach(a, payload);
+        case SRV_GOVERNOR:          return Configure_governor(a);
+        case SRV_SNAPSHOT:          return Snapshot(payload);
+        case SRV_SNAPSHOT_DIFF:     return Snapshot_diff();
+        case SRV_SHUTDOWN:
+            serving = false;
+            return SCHED_SUCCESS;
+    }
+    return SCHED_FAIL;
+}
+
+// Runs every whole request in the client's read buffer, replies are queued in request order
+static void handleRequests(Client* client) {
+    int pos = 0;
+    while(serving && Sched_running() && client->fd >= 0 && client->inLength - pos >= (int)sizeof(Srv_request)) {
+        Srv_request req;
+        memcpy(&req, client->in + pos, sizeof(req));
+        if(client->inLength - pos < (int)sizeof(req) + req.length)
+            break;  // Rest of the payload has not arrived yet
+        char payload[256];
+        memcpy(payload, client->in + pos + sizeof(req), req.length);
+        payload[req.length] = '\0';
+        pos += sizeof(req) + req.length;
+        long value = req.op < SRV_NUM_OPS ? execute(client, &req, payload) : SCHED_FAIL;
+        Srv_frame reply = {SRV_FRAME_REPLY, 0, 0, (int32_t)req.seq, value};
+        queueFrame(client, &reply);
+    }
+    if(client->fd < 0)
+        return;
+    client->inLength -= pos;
+    memmove(client->in, client->in + pos, client->inLength);
+}
+
+// Reads everything the client sent and runs its requests
+static void readClient(Client* client) {
+    while(client->fd >= 0) {
+        ssize_t n = read(client->fd, client->in + client->inLength, SRV_INPUT - client->inLength);
+        if(n > 0) {
+            client->inLength += n;
+            handleRequests(client);
+            continue;
+        }
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            closeClient(client);
+        break;
+    }
+}
+
+static void acceptClients(int listenFd) {
+    int fd;
+    while((fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK)) >= 0) {
+        int slot = 0;
+        while(slot < SRV_MAX_CLIENTS && clients[slot] && clients[slot]->fd >= 0)
+            slot++;
+        if(slot == SRV_MAX_CLIENTS || (!clients[slot] && !(clients[slot] = malloc(sizeof(Client))))) {
+            printf("Error: Too many clients, connection refused\n");
+            close(fd);
+            continue;
+        }
+        Client* client = clients[slot];
+        memset(client, 0, sizeof(Client));
+        client->fd = fd;
+        struct epoll_event ev = {.events = EPOLLIN | EPOLLRDHUP, .data.ptr = client};
+        if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            client->fd = -1;
+            continue;
+        }
+        printf("Client connected on descriptor %d\n", fd);
+    }
+}
+
+// --------------------------------------- Server functions ---------------------------------------
+
+// Serves the running simulation on the socket at path
+int Server_run(const char* path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        printf("Error: Socket path %s is too long\n", path);
+        return SRV_FAIL;
+    }
+    strcpy(addr.sun_path, path);
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(listenFd < 0)
+        return SRV_FAIL;
+    unlink(path);   // Left behind by an earlier server
+    if(bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, SRV_MAX_CLIENTS) < 0 ||
+        (epollFd = epoll_create1(0)) < 0) {
+        printf("Error: Cannot listen on %s\n", path);
+        close(listenFd);
+        return SRV_FAIL;
+    }
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};  // NULL marks the listening socket
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    printf("Success: Serving on %s\n", path);
+    Sched_set_reports(false);
+    Sched_on_event(&streamEvent, NULL);
+    serving = true;
+    struct epoll_event ready[64];
+    while(serving && Sched_running()) {
+        int n = epoll_wait(epollFd, ready, 64, -1);
+        if(n < 0 && errno != EINTR)
+            break;
+        for(int i = 0; i < n; i++) {
+            Client* client = ready[i].data.ptr;
+            if(client == NULL) {
+                acceptClients(listenFd);
+                continue;
+            }
+            if(client->fd < 0)  // Closed earlier in this round
+                continue;
+            if(ready[i].events & EPOLLIN)
+                readClient(client);
+            if(client->fd >= 0 && (ready[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) && !(ready[i].events & EPOLLIN))
+                closeClient(client);
+        }
+        // Replies and the events they caused go out together, to every client that has some
+        for(int i = 0; i < SRV_MAX_CLIENTS; i++) {
+            if(clients[i] && clients[i]->fd >= 0)
+                flushClient(clients[i]);
+        }
+    }
+
+    Sched_on_event(NULL, NULL);
+    Sched_set_reports(true);
+    for(int i = 0; i < SRV_MAX_CLIENTS; i++) {
+        if(clients[i] && clients[i]->fd >= 0) {
+            Client* client = clients[i];
+            ssize_t n;  // Best effort for the last replies, e.g. to SRV_SHUTDOWN
+            while(client->outLength > 0 && (n = write(client->fd, client->out + client->outStart, client->outLength)) > 0) {
+                client->outStart += n;
+                client->outLength -= n;
+            }
+            closeClient(client);
+        }
+        free(clients[i]);
+        clients[i] = NULL;
+    }
+    close(epollFd);
+    close(listenFd);
+    unlink(path);
+    printf("Success: Server on %s stopped\n", path);
+    return SRV_SUCCESS;
+}
@@ -0,0 +1,92 @@
+// Control server header file
+// Serves the simulation on a Unix domain socket so that other local programs can drive it.
+// Clients write batches of request frames and read back reply frames in request order,
+// interleaved with event frames if they subscribed to scheduling events. Every field is in host
+// byte order, a request is followed by length bytes of payload (names and messages)
+#ifndef _SERVER_H_
+#define _SERVER_H_
+#include <stdint.h>
+
+#define SRV_SUCCESS 0
+#define SRV_FAIL -1
+#define SRV_MAX_CLIENTS 64
+#define SRV_MAX_OUTPUT (16 << 20)   // Pending output after which a client that stopped reading is dropped
+
+enum srv_op{        // Arguments in arg[], strings in the payload
+    SRV_CREATE,     // priority, replies with the PID
+    SRV_FORK,       // replies with the PID
+    SRV_KILL,       // pid
+    SRV_EXIT,
+    SRV_QUANTUM,
+    SRV_SEND,       // pid, payload: message
+    SRV_RECEIVE,
+    SRV_REPLY,      // pid, payload: message
+    SRV_NEW_SEM,    // semaphore ID, value
+    SRV_SEM_P,      // semaphore ID, deadline
+    SRV_SEM_V,      // semaphore ID
+    SRV_SEM_V_N,    // semaphore ID, count (0 = broadcast)
+    SRV_WAIT,
+    SRV_KILL_GROUP, // group ID
+    SRV_SUSPEND_GROUP,  // group ID
+    SRV_RESUME_GROUP,   // group ID
+    SRV_PRIORITY_GROUP, // group ID, priority
+    SRV_ACCESS,     // virtual page, write (0 = read)
+    SRV_DEVICE_IO,  // device ID, sector
+    SRV_ARRIVAL,    // priority, delay
+    SRV_RUN,        // ticks
+    SRV_BOOST,
+    SRV_QUANTUM_LENGTH, // priority level (3 = all), ticks
+    SRV_BOOST_PERIOD,   // ticks (0 = never)
+    SRV_SEM_ORDER,  // semaphore ID, order
+    SRV_CHAN_OPEN,  // capacity, payload: name
+    SRV_CHAN_SEND,  // payload: name, '\0', message
+    SRV_CHAN_RECEIVE,   // payload: name
+    SRV_TOPIC_OPEN, // payload: name
+    SRV_TOPIC_JOIN, // 1 = subscribe, 0 = unsubscribe, payload: name
+    SRV_TOPIC_PUBLISH,  // payload: name, '\0', message
+    SRV_TOPIC_RECEIVE,  // payload: name
+    SRV_EVENTS,     // 1 = stream scheduling events to this client, 0 = stop
+    SRV_TIME,       // replies with the simulated time
+    SRV_CURRENT,    // replies with the PID of the running process
+    SRV_SHUTDOWN,   // stops the server once the replies have been sent
+    SRV_STARVATION, // ready ticks before a starvation alarm (0 = never)
+    SRV_CREATE_RT,  // policy (1 = FIFO, 2 = RR), real-time priority, replies with the PID
+    SRV_PREEMPTION, // 1 = preemptive mode, 0 = off, wakeup granularity in ticks
+    SRV_CGROUP_CREATE,  // weight, payload: name, '\0', parent name
+    SRV_CGROUP_LIMIT,   // quota, period, payload: name
+    SRV_CGROUP_ATTACH,  // pid, payload: name
+    SRV_GOVERNOR,   // 0 = performance, 1 = powersave, 2 = ondemand
+    SRV_SNAPSHOT,   // payload: file name, the queues are written to it as JSON
+    SRV_SNAPSHOT_DIFF,  // reports the processes that changed queue since the last snapshot
+    SRV_NUM_OPS
+};
+
+typedef struct Srv_request_s Srv_request;
+struct Srv_request_s{
+    uint32_t seq;       // Chosen by the client, echoed in the reply
+    uint8_t op;         // enum srv_op
+    uint8_t length;     // Bytes of payload following the request
+    uint16_t reserved;
+    int32_t arg[2];
+};
+
+enum srv_frame_kind{
+    SRV_FRAME_REPLY,    // id = request seq, value = result (SCHED_SUCCESS/SCHED_FAIL, a PID or a time)
+    SRV_FRAME_EVENT     // event = enum sched_event, id = PID, value = simulated time
+};
+
+typedef struct Srv_frame_s Srv_frame;
+struct Srv_frame_s{
+    uint8_t kind;       // enum srv_frame_kind
+    uint8_t event;
+    uint16_t reserved;
+    int32_t id;
+    int64_t value;
+};
+
+// Serves the running simulation on the socket at path until a client sends SRV_SHUTDOWN or
+// the init process exits. Command reports are turned off while serving
+// Returns SRV_SUCCESS, or SRV_FAIL if the socket could not be set up
+int Server_run(const char* path);
+
+#endif
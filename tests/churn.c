@@ -0,0 +1,86 @@
+// Guard test: once the pools have grown, creating and exiting processes makes no heap allocations.
+// Linked with --wrap so that every malloc, calloc and realloc made by the library is counted
+#include "../commands.h"
+#include "../PCB.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WARM_PROCESSES 2048     // Grows every pool past its first chunk
+#define CHURN_ROUNDS 100000
+
+static long heapCalls = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size){
+    heapCalls++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size){
+    heapCalls++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size){
+    heapCalls++;
+    return __real_realloc(ptr, size);
+}
+
+// Creates a process and exits it once it runs, init is running in between
+static int churn_one(int priority){
+    int pid = Create(priority);
+    if (pid == SCHED_FAIL || Sched_current() != pid){
+        printf("FAIL: process %d did not start running\n", pid);
+        return SCHED_FAIL;
+    }
+    return Exit();
+}
+
+int main(){
+    start_simulator();
+    Sched_set_reports(false);
+
+    // Warm up: reach the peak process count once, then exit them all
+    for (int i = 0; i < WARM_PROCESSES; i++){
+        if (Create(i % 3) == SCHED_FAIL){
+            printf("FAIL: could not create warm-up process %d\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+    for (int i = 0; i < WARM_PROCESSES; i++){
+        if (Exit() != SCHED_SUCCESS){
+            printf("FAIL: could not exit warm-up process %d\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+    for (int i = 0; i < 3; i++){   // Lets every first-use path allocate before counting starts
+        if (churn_one(i) != SCHED_SUCCESS){
+            return EXIT_FAILURE;
+        }
+    }
+
+    int poolAllocs = PCB_heap_allocs();
+    long calls = heapCalls;
+    for (int i = 0; i < CHURN_ROUNDS; i++){
+        if (churn_one(i % 3) != SCHED_SUCCESS){
+            return EXIT_FAILURE;
+        }
+    }
+    int failed = 0;
+    if (PCB_heap_allocs() != poolAllocs){
+        printf("FAIL: PCB pools made %d heap allocation(s) during churn\n", PCB_heap_allocs() - poolAllocs);
+        failed = 1;
+    }
+    if (heapCalls != calls){
+        printf("FAIL: %ld heap allocation(s) during %d create/exit rounds\n", heapCalls - calls, CHURN_ROUNDS);
+        failed = 1;
+    }
+    stop_simulator();
+    if (!failed){
+        printf("PASS: %d create/exit rounds made no heap allocations\n", CHURN_ROUNDS);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
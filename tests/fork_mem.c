@@ -0,0 +1,69 @@
+// Copy-on-write test: a forked child shares its parent's address space, resident pages included,
+// until one of them writes to it and takes a private copy
+#include "../commands.h"
+#include "../PCB.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PAGES 10
+
+static int failed = 0;
+
+static void check(bool ok, const char* what){
+    if (!ok){
+        printf("FAIL: %s\n", what);
+        failed = 1;
+    }
+}
+
+int main(){
+    start_simulator();
+    Sched_set_reports(false);
+    Configure_memory(4 * PAGES, MEM_LRU, 0, MEM_DEFAULT_WINDOW);    // No fault latency, nothing blocks
+
+    int parentPid = Create(MED);
+    check(Sched_current() == parentPid, "the parent did not start running");
+    for (int vpn = 0; vpn < PAGES; vpn++){
+        Access(vpn, false);
+    }
+    PCB* parent = PCB_find(parentPid);
+    int childPid = Fork();
+    PCB* child = PCB_find(childPid);
+    if (childPid == SCHED_FAIL || child == NULL){
+        printf("FAIL: fork failed\n");
+        return EXIT_FAILURE;
+    }
+
+    check(child->cold->mm == parent->cold->mm && child->cold->mm->refCount == 2, "the child does not share its parent's address space");
+    check(child->cold->mm->resident == PAGES, "the child does not keep its parent's resident pages");
+    int privateBytes;
+    int total = PCB_memory(child, &privateBytes);
+    check(total - privateBytes == Mem_space_bytes(child->cold->mm) / 2, "the shared address space is not split between the sharers");
+
+    Quantum();
+    check(Sched_current() == childPid, "the child did not get the CPU");
+    int faults = child->cold->mm->faults;
+    for (int vpn = 0; vpn < PAGES; vpn++){  // Reads hit the shared pages
+        Access(vpn, false);
+    }
+    check(child->cold->mm->faults == faults, "the child faulted reading its parent's resident pages");
+
+    Access(0, true);
+    check(child->cold->mm != parent->cold->mm, "the first write did not copy the shared address space");
+    check(child->cold->mm->refCount == 1 && parent->cold->mm->refCount == 1, "the copy did not end the share");
+    check(child->cold->mm->resident == PAGES && parent->cold->mm->resident == PAGES, "the copy lost resident pages");
+    check(PCB_memory(child, &privateBytes) == privateBytes, "the copied address space is not private");
+    faults = child->cold->mm->faults;
+    for (int vpn = 0; vpn < PAGES; vpn++){
+        Access(vpn, true);
+    }
+    check(child->cold->mm->faults == faults, "the child faulted writing its private copy");
+
+    Exit();
+    Exit();
+    stop_simulator();
+    if (!failed){
+        printf("PASS: a forked child kept its parent's %d resident pages until it wrote\n", PAGES);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
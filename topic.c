@@ -0,0 +1,208 @@
+#include "topic.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct Topic_msg_s{
+    int refCount;   // Inboxes still holding the message
+    int publisher;
+    char text[TOPIC_MAX_MSG];
+}; typedef struct Topic_msg_s Topic_msg;
+
+// A subscriber's inbox is a growable ring of message pointers
+struct Subscriber_s{
+    int pid;
+    Topic_msg** inbox;
+    int head;
+    int count;
+    int capacity;
+}; typedef struct Subscriber_s Subscriber;
+
+struct Topic_s{
+    bool open;
+    char name[TOPIC_MAX_NAME];
+    Subscriber* subs;
+    int numSubs;
+    int maxSubs;
+    // Statistics
+    long published;
+    long deliveries;
+    long liveMessages;  // Published messages not yet received by every subscriber
+}; typedef struct Topic_s Topic;
+
+static Topic topics[TOPIC_MAX_TOPICS];
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static void release(Topic* topic, Topic_msg* msg) {
+    if(--msg->refCount == 0) {
+        free(msg);
+        topic->liveMessages--;
+    }
+}
+
+static Subscriber* findSub(Topic* topic, int pid) {
+    for(int i = 0; i < topic->numSubs; i++) {
+        if(topic->subs[i].pid == pid)
+            return &topic->subs[i];
+    }
+    return NULL;
+}
+
+// Makes room for one more message in the inbox
+static bool growInbox(Subscriber* sub) {
+    if(sub->count < sub->capacity)
+        return true;
+    int capacity = sub->capacity ? sub->capacity * 2 : 8;
+    Topic_msg** inbox = malloc(capacity * sizeof(Topic_msg*));
+    if(inbox == NULL)
+        return false;
+    for(int i = 0; i < sub->count; i++)
+        inbox[i] = sub->inbox[(sub->head + i) % sub->capacity];
+    free(sub->inbox);
+    sub->inbox = inbox;
+    sub->capacity = capacity;
+    sub->head = 0;
+    return true;
+}
+
+// Drops every unread message of the subscriber at index i and removes it
+static void removeSub(Topic* topic, int i) {
+    Subscriber* sub = &topic->subs[i];
+    for(int m = 0; m < sub->count; m++)
+        release(topic, sub->inbox[(sub->head + m) % sub->capacity]);
+    free(sub->inbox);
+    topic->subs[i] = topic->subs[--topic->numSubs];    // Order of subscribers does not matter
+}
+
+// ---------------------------------------- Topic functions ---------------------------------------
+
+// Opens a topic called name
+int Topic_open(const char* name) {
+    if(strlen(name) >= TOPIC_MAX_NAME || Topic_find(name) != TOPIC_FAIL)
+        return TOPIC_FAIL;
+    for(int id = 0; id < TOPIC_MAX_TOPICS; id++) {
+        if(topics[id].open)
+            continue;
+        topics[id] = (Topic){0};
+        topics[id].open = true;
+        strcpy(topics[id].name, name);
+        return id;
+    }
+    return TOPIC_FAIL;
+}
+
+// Returns the ID of the topic called name
+int Topic_find(const char* name) {
+    for(int id = 0; id < TOPIC_MAX_TOPICS; id++) {
+        if(topics[id].open && strcmp(topics[id].name, name) == 0)
+            return id;
+    }
+    return TOPIC_FAIL;
+}
+
+const char* Topic_name(int id) {
+    return topics[id].name;
+}
+
+// Subscribes process pid to topic id
+int Topic_subscribe(int id, int pid) {
+    Topic* topic = &topics[id];
+    if(findSub(topic, pid))
+        return TOPIC_FAIL;
+    if(topic->numSubs == topic->maxSubs) {
+        int maxSubs = topic->maxSubs ? topic->maxSubs * 2 : 4;
+        Subscriber* subs = realloc(topic->subs, maxSubs * sizeof(Subscriber));
+        if(subs == NULL)
+            return TOPIC_FAIL;
+        topic->subs = subs;
+        topic->maxSubs = maxSubs;
+    }
+    topic->subs[topic->numSubs++] = (Subscriber){pid, NULL, 0, 0, 0};
+    return TOPIC_SUCCESS;
+}
+
+// Unsubscribes process pid
+int Topic_unsubscribe(int id, int pid) {
+    Topic* topic = &topics[id];
+    Subscriber* sub = findSub(topic, pid);
+    if(sub == NULL)
+        return TOPIC_FAIL;
+    removeSub(topic, sub - topic->subs);
+    return TOPIC_SUCCESS;
+}
+
+bool Topic_subscribed(int id, int pid) {
+    return findSub(&topics[id], pid) != NULL;
+}
+
+// Publishes text to every subscriber of topic id as a single shared message
+int Topic_publish(int id, int publisher, const char* text) {
+    Topic* topic = &topics[id];
+    topic->published++;
+    if(topic->numSubs == 0)
+        return 0;
+    for(int i = 0; i < topic->numSubs; i++) {   // Reserve every slot first so delivery cannot fail halfway
+        if(!growInbox(&topic->subs[i]))
+            return TOPIC_FAIL;
+    }
+    Topic_msg* msg = malloc(sizeof(Topic_msg));
+    if(msg == NULL)
+        return TOPIC_FAIL;
+    msg->refCount = topic->numSubs;
+    msg->publisher = publisher;
+    strncpy(msg->text, text, TOPIC_MAX_MSG - 1);
+    msg->text[TOPIC_MAX_MSG - 1] = '\0';
+    for(int i = 0; i < topic->numSubs; i++) {
+        Subscriber* sub = &topic->subs[i];
+        sub->inbox[(sub->head + sub->count) % sub->capacity] = msg;
+        sub->count++;
+    }
+    topic->liveMessages++;
+    topic->deliveries += topic->numSubs;
+    return topic->numSubs;
+}
+
+// Takes the oldest unread message of subscriber pid
+bool Topic_receive(int id, int pid, char* text, int* publisher) {
+    Topic* topic = &topics[id];
+    Subscriber* sub = findSub(topic, pid);
+    if(sub == NULL || sub->count == 0)
+        return false;
+    Topic_msg* msg = sub->inbox[sub->head];
+    sub->head = (sub->head + 1) % sub->capacity;
+    sub->count--;
+    strcpy(text, msg->text);
+    *publisher = msg->publisher;
+    release(topic, msg);
+    return true;
+}
+
+// Unsubscribes process pid from every topic
+void Topic_drop_process(int pid) {
+    for(int id = 0; id < TOPIC_MAX_TOPICS; id++) {
+        if(topics[id].open)
+            Topic_unsubscribe(id, pid);
+    }
+}
+
+// Prints subscriber and message statistics of every open topic
+void Topic_print_stats() {
+    for(int id = 0; id < TOPIC_MAX_TOPICS; id++) {
+        Topic* topic = &topics[id];
+        if(!topic->open)
+            continue;
+        printf("Topic %s: %d subscriber(s), %ld published, %ld delivered, %ld message(s) still unread\n",
+            topic->name, topic->numSubs, topic->published, topic->deliveries, topic->liveMessages);
+    }
+}
+
+// Closes every topic and frees all messages
+void Topic_close_all() {
+    for(int id = 0; id < TOPIC_MAX_TOPICS; id++) {
+        while(topics[id].numSubs > 0)
+            removeSub(&topics[id], 0);
+        free(topics[id].subs);
+        topics[id] = (Topic){0};
+    }
+}
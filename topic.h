@@ -0,0 +1,51 @@
+// Publish/subscribe topic header file
+// A published message is stored once with a reference count, every subscriber's inbox holds a
+// pointer to it and the message is freed when the last subscriber has received it
+#ifndef _TOPIC_H_
+#define _TOPIC_H_
+#include <stdbool.h>
+
+#define TOPIC_MAX_TOPICS 8
+#define TOPIC_MAX_NAME 16
+#define TOPIC_MAX_MSG 100
+#define TOPIC_SUCCESS 0
+#define TOPIC_FAIL -1
+
+// Opens a topic called name
+// Returns the topic ID or TOPIC_FAIL (name taken or too long, no free topic)
+int Topic_open(const char* name);
+
+// Returns the ID of the topic called name, TOPIC_FAIL if there is none
+int Topic_find(const char* name);
+
+// Returns the name of topic id
+const char* Topic_name(int id);
+
+// Subscribes process pid to topic id, it receives messages published from now on
+// Returns TOPIC_SUCCESS or TOPIC_FAIL (already subscribed, out of memory)
+int Topic_subscribe(int id, int pid);
+
+// Unsubscribes process pid, dropping its unread messages
+// Returns TOPIC_SUCCESS or TOPIC_FAIL (not subscribed)
+int Topic_unsubscribe(int id, int pid);
+
+bool Topic_subscribed(int id, int pid);
+
+// Publishes text to every subscriber of topic id as a single shared message
+// Returns the number of subscribers it was delivered to, or TOPIC_FAIL if out of memory
+int Topic_publish(int id, int publisher, const char* text);
+
+// Takes the oldest unread message of subscriber pid into text (TOPIC_MAX_MSG bytes)
+// Returns false if the inbox is empty or pid is not subscribed
+bool Topic_receive(int id, int pid, char* text, int* publisher);
+
+// Unsubscribes process pid from every topic, used when a process is terminated
+void Topic_drop_process(int pid);
+
+// Prints subscriber and message statistics of every open topic
+void Topic_print_stats();
+
+// Closes every topic and frees all messages
+void Topic_close_all();
+
+#endif
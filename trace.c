@@ -0,0 +1,299 @@
+#include "trace.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAP_EMPTY -1
+#define MAP_DELETED -2
+
+// Trace pid -> simulator PID, open addressing with linear probing
+struct Map_entry_s{
+    int pid;        // MAP_EMPTY or MAP_DELETED for unused slots
+    int simPid;
+}; typedef struct Map_entry_s Map_entry;
+
+struct Trace_s{
+    int fd;
+    long size;
+    long pageSize;
+    // Mapped window [mapStart, mapStart + mapLength) of the file, pos is the next unread byte
+    char* map;
+    long mapStart;
+    long mapLength;
+    long pos;
+    long skipped;
+    Map_entry* table;
+    int capacity;   // Power of two
+    int used;       // Live and deleted slots
+    int live;
+};
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// Maps the window starting at the page holding offset
+static bool mapWindow(Trace* trace, long offset) {
+    if(trace->map)
+        munmap(trace->map, trace->mapLength);
+    trace->map = NULL;
+    trace->mapStart = offset - offset % trace->pageSize;
+    trace->mapLength = trace->size - trace->mapStart;
+    if(trace->mapLength > TRACE_WINDOW)
+        trace->mapLength = TRACE_WINDOW;
+    char* map = mmap(NULL, trace->mapLength, PROT_READ, MAP_PRIVATE, trace->fd, trace->mapStart);
+    if(map == MAP_FAILED)
+        return false;
+    madvise(map, trace->mapLength, MADV_SEQUENTIAL);
+    trace->map = map;
+    return true;
+}
+
+// Returns the integer following key in [args, end), -1 if the key is missing
+static long field(const char* args, const char* end, const char* key) {
+    size_t keyLength = strlen(key);
+    for(const char* p = args; p + keyLength <= end; p++) {
+        if((p == args || p[-1] == ' ') && memcmp(p, key, keyLength) == 0)
+            return strtol(p + keyLength, NULL, 10);
+    }
+    return -1;
+}
+
+// Returns the first character of the value of key in [args, end), '\0' if the key is missing
+static char fieldChar(const char* args, const char* end, const char* key) {
+    size_t keyLength = strlen(key);
+    for(const char* p = args; p + keyLength < end; p++) {
+        if((p == args || p[-1] == ' ') && memcmp(p, key, keyLength) == 0)
+            return p[keyLength];
+    }
+    return '\0';
+}
+
+// Finds "name: " in the line, returns a pointer to name or NULL
+static const char* findEvent(const char* line, const char* end, const char* name) {
+    size_t nameLength = strlen(name);
+    for(const char* p = line; p + nameLength + 2 <= end; p++) {
+        if(memcmp(p, name, nameLength) == 0 && p[nameLength] == ':' && p[nameLength + 1] == ' ' &&
+            (p == line || p[-1] == ' ' || p[-1] == ':'))
+            return p;
+    }
+    return NULL;
+}
+
+// Parses the "seconds.fraction:" timestamp in front of the event name into microseconds
+static bool parseTime(const char* line, const char* event, long* time) {
+    const char* p = event;
+    if(p - line >= 6 && memcmp(p - 6, "sched:", 6) == 0)   // perf prefixes the subsystem
+        p -= 6;
+    while(p > line && p[-1] == ' ')
+        p--;
+    if(p == line || p[-1] != ':')
+        return false;
+    const char* end = --p;
+    while(p > line && (isdigit((unsigned char)p[-1]) || p[-1] == '.'))
+        p--;
+    if(p == end)
+        return false;
+    long seconds = 0;
+    long micros = 0;
+    int digits = -1;    // Fraction digits seen, -1 before the point
+    for(; p < end; p++) {
+        if(*p == '.')
+            digits = 0;
+        else if(digits < 0)
+            seconds = seconds * 10 + (*p - '0');
+        else if(digits < 6) {   // Nanosecond timestamps are truncated
+            micros = micros * 10 + (*p - '0');
+            digits++;
+        }
+    }
+    for(; digits < 6; digits++)
+        micros *= 10;
+    *time = seconds * 1000000 + micros;
+    return true;
+}
+
+// Parses one line, returns false if it is not a supported scheduler event
+static bool parseLine(const char* line, const char* end, Trace_event* ev) {
+    const char* event;
+    const char* args;
+    ev->prio = ev->otherPrio = -1;
+    ev->other = -1;
+    ev->sleeping = false;
+    if((event = findEvent(line, end, "sched_switch"))) {
+        args = event + strlen("sched_switch: ");
+        ev->type = TRACE_SWITCH;
+        ev->pid = field(args, end, "prev_pid=");
+        ev->prio = field(args, end, "prev_prio=");
+        ev->other = field(args, end, "next_pid=");
+        ev->otherPrio = field(args, end, "next_prio=");
+        char state = fieldChar(args, end, "prev_state=");
+        if(state == '\0' || ev->other < 0)  // Old compact format without key=value fields
+            return false;
+        ev->sleeping = state != 'R';
+    } else if((event = findEvent(line, end, "sched_wakeup")) || (event = findEvent(line, end, "sched_wakeup_new"))) {
+        args = strchr(event, ':') + 2;
+        ev->type = TRACE_WAKEUP;
+        ev->pid = field(args, end, "pid=");
+        ev->prio = field(args, end, "prio=");
+    } else if((event = findEvent(line, end, "sched_process_fork"))) {
+        args = event + strlen("sched_process_fork: ");
+        ev->type = TRACE_FORK;
+        ev->pid = field(args, end, "pid=");
+        ev->other = field(args, end, "child_pid=");
+        if(ev->other < 0)
+            return false;
+    } else if((event = findEvent(line, end, "sched_process_exit"))) {
+        args = event + strlen("sched_process_exit: ");
+        ev->type = TRACE_EXIT;
+        ev->pid = field(args, end, "pid=");
+        ev->prio = field(args, end, "prio=");
+    } else
+        return false;
+    return ev->pid >= 0 && parseTime(line, event, &ev->time);
+}
+
+static unsigned int hashPid(int pid) {
+    return (unsigned int)pid * 2654435761u;
+}
+
+// Rebuilds the table with the given capacity, dropping deleted slots
+static bool rehash(Trace* trace, int capacity) {
+    Map_entry* table = malloc(capacity * sizeof(Map_entry));
+    if(table == NULL)
+        return false;
+    for(int i = 0; i < capacity; i++)
+        table[i].pid = MAP_EMPTY;
+    int used = 0;
+    for(int i = 0; i < trace->capacity; i++) {
+        if(trace->table[i].pid < 0)
+            continue;
+        unsigned int slot = hashPid(trace->table[i].pid) & (capacity - 1);
+        while(table[slot].pid != MAP_EMPTY)
+            slot = (slot + 1) & (capacity - 1);
+        table[slot] = trace->table[i];
+        used++;
+    }
+    free(trace->table);
+    trace->table = table;
+    trace->capacity = capacity;
+    trace->used = trace->live = used;
+    return true;
+}
+
+// Returns the slot holding pid, -1 if it is not in the table
+static int findSlot(Trace* trace, int pid) {
+    unsigned int slot = hashPid(pid) & (trace->capacity - 1);
+    while(trace->table[slot].pid != MAP_EMPTY) {
+        if(trace->table[slot].pid == pid)
+            return slot;
+        slot = (slot + 1) & (trace->capacity - 1);
+    }
+    return -1;
+}
+
+// ---------------------------------------- Trace functions ---------------------------------------
+
+// Opens the trace at path
+Trace* Trace_open(const char* path) {
+    struct stat st;
+    char magic[8];
+    int fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return NULL;
+    if(fstat(fd, &st) != 0 || (read(fd, magic, 8) == 8 && memcmp(magic, "PERFILE", 7) == 0)) {
+        close(fd);
+        return NULL;
+    }
+    Trace* trace = calloc(1, sizeof(Trace));
+    if(trace == NULL || !rehash(trace, 64)) {
+        free(trace);
+        close(fd);
+        return NULL;
+    }
+    trace->fd = fd;
+    trace->size = st.st_size;
+    trace->pageSize = sysconf(_SC_PAGESIZE);
+    return trace;
+}
+
+// Stores the next scheduler event in ev
+int Trace_next(Trace* trace, Trace_event* ev) {
+    while(trace->pos < trace->size) {
+        if(trace->map == NULL || trace->pos >= trace->mapStart + trace->mapLength) {
+            if(!mapWindow(trace, trace->pos))
+                return TRACE_FAIL;
+        }
+        const char* line = trace->map + (trace->pos - trace->mapStart);
+        const char* windowEnd = trace->map + trace->mapLength;
+        const char* end = memchr(line, '\n', windowEnd - line);
+        if(end == NULL) {
+            if(trace->mapStart + trace->mapLength < trace->size && trace->pos > trace->mapStart) {
+                if(!mapWindow(trace, trace->pos))   // Line runs past the window, slide it
+                    return TRACE_FAIL;
+                continue;
+            }
+            end = windowEnd;    // Last line without a newline, or a line longer than a window
+        }
+        trace->pos += end - line + 1;
+        if(parseLine(line, end, ev))
+            return TRACE_EVENT;
+        trace->skipped++;
+    }
+    return TRACE_END;
+}
+
+// Returns the number of lines skipped so far
+long Trace_skipped(Trace* trace) {
+    return trace->skipped;
+}
+
+// Maps trace pid to simulator PID
+bool Trace_map_set(Trace* trace, int pid, int simPid) {
+    int existing = findSlot(trace, pid);
+    if(existing >= 0) {
+        trace->table[existing].simPid = simPid;
+        return true;
+    }
+    if(2 * (trace->used + 1) > trace->capacity) {   // Grow only if the live tasks need it
+        int capacity = 4 * (trace->live + 1) > trace->capacity ? trace->capacity * 2 : trace->capacity;
+        if(!rehash(trace, capacity))
+            return false;
+    }
+    unsigned int slot = hashPid(pid) & (trace->capacity - 1);
+    while(trace->table[slot].pid >= 0)
+        slot = (slot + 1) & (trace->capacity - 1);
+    if(trace->table[slot].pid == MAP_EMPTY)
+        trace->used++;
+    trace->table[slot].pid = pid;
+    trace->table[slot].simPid = simPid;
+    trace->live++;
+    return true;
+}
+
+// Returns the simulator PID of trace pid
+int Trace_map_get(Trace* trace, int pid) {
+    int slot = findSlot(trace, pid);
+    return slot >= 0 ? trace->table[slot].simPid : -1;
+}
+
+void Trace_map_remove(Trace* trace, int pid) {
+    int slot = findSlot(trace, pid);
+    if(slot >= 0) {
+        trace->table[slot].pid = MAP_DELETED;
+        trace->live--;
+    }
+}
+
+// Unmaps and closes the trace
+void Trace_close(Trace* trace) {
+    if(trace == NULL)
+        return;
+    if(trace->map)
+        munmap(trace->map, trace->mapLength);
+    close(trace->fd);
+    free(trace->table);
+    free(trace);
+}
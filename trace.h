@@ -0,0 +1,57 @@
+// Scheduler trace reader header file
+// Streams sched_switch, sched_wakeup, sched_process_fork and sched_process_exit events out of
+// the text output of ftrace (/sys/kernel/tracing/trace, trace-cmd report) or perf sched script.
+// The file is mapped one window at a time so memory use does not depend on the trace size
+#ifndef _TRACE_H_
+#define _TRACE_H_
+#include <stdbool.h>
+
+#define TRACE_WINDOW (16L << 20)    // Bytes of the file mapped at a time
+#define TRACE_EVENT 1
+#define TRACE_END 0
+#define TRACE_FAIL -1
+
+enum trace_type{
+    TRACE_SWITCH,   // pid stops running (blocks if sleeping is true), other starts running
+    TRACE_WAKEUP,   // pid is woken (sched_wakeup and sched_wakeup_new)
+    TRACE_FORK,     // pid forks other
+    TRACE_EXIT      // pid exits
+};
+
+typedef struct Trace_event_s Trace_event;
+struct Trace_event_s{
+    int type;
+    long time;      // Microseconds
+    int pid;
+    int prio;       // Kernel priority of pid (0-139, 120 = nice 0), -1 if not in the trace
+    int other;      // Next task of a switch, child of a fork
+    int otherPrio;
+    bool sleeping;  // Switched out task left the run queue (prev_state other than R)
+};
+
+typedef struct Trace_s Trace;
+
+// Opens the trace at path. Binary perf.data files are refused, they need converting with
+// perf sched script first. Returns NULL if failed
+Trace* Trace_open(const char* path);
+
+// Stores the next scheduler event in ev, skipping lines that are not one
+// Returns TRACE_EVENT, TRACE_END or TRACE_FAIL (the file could not be mapped)
+int Trace_next(Trace* trace, Trace_event* ev);
+
+// Returns the number of lines skipped so far (other events, headers, unrecognised formats)
+long Trace_skipped(Trace* trace);
+
+// Maps trace pid to simulator PID, the table only holds live tasks
+// Returns false if out of memory
+bool Trace_map_set(Trace* trace, int pid, int simPid);
+
+// Returns the simulator PID of trace pid, -1 if it has none
+int Trace_map_get(Trace* trace, int pid);
+
+void Trace_map_remove(Trace* trace, int pid);
+
+// Unmaps and closes the trace
+void Trace_close(Trace* trace);
+
+#endif
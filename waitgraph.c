@@ -0,0 +1,141 @@
+#include "waitgraph.h"
+#include <stddef.h>
+
+// The represented forest has an edge from each node to the node it waits for, so a root is a
+// node that is not waiting or whose edge closed a cycle and was left out of the forest
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+// True if x is the root of its splay tree (its up pointer, if any, is a path parent)
+static bool isSplayRoot(Wfg_node* x) {
+    return x->up == NULL || (x->up->left != x && x->up->right != x);
+}
+
+static void rotate(Wfg_node* x) {
+    Wfg_node* p = x->up;
+    Wfg_node* g = p->up;
+    if(!isSplayRoot(p)) {
+        if(g->left == p)
+            g->left = x;
+        else
+            g->right = x;
+    }
+    x->up = g;
+    if(p->left == x) {
+        p->left = x->right;
+        if(x->right)
+            x->right->up = p;
+        x->right = p;
+    } else {
+        p->right = x->left;
+        if(x->left)
+            x->left->up = p;
+        x->left = p;
+    }
+    p->up = x;
+}
+
+static void splay(Wfg_node* x) {
+    while(!isSplayRoot(x)) {
+        Wfg_node* p = x->up;
+        if(!isSplayRoot(p))
+            rotate((p->left == x) == (p->up->left == p) ? p : x);
+        rotate(x);
+    }
+}
+
+// Makes the path from the root of x's tree down to x preferred, x ends up as the splay root with
+// its ancestors in the left subtree
+static void access(Wfg_node* x) {
+    Wfg_node* last = NULL;
+    for(Wfg_node* y = x; y; y = y->up) {
+        splay(y);
+        y->right = last;
+        last = y;
+    }
+    splay(x);
+}
+
+static Wfg_node* findRoot(Wfg_node* x) {
+    access(x);
+    while(x->left)
+        x = x->left;
+    splay(x);
+    return x;
+}
+
+// Hangs tree root x under y
+static void link(Wfg_node* x, Wfg_node* y) {
+    access(x);
+    x->up = y;
+}
+
+// Detaches x from its parent in the forest
+static void cut(Wfg_node* x) {
+    access(x);
+    if(x->left) {
+        x->left->up = NULL;
+        x->left = NULL;
+    }
+}
+
+// ---------------------------------------- Graph functions ---------------------------------------
+
+// Sets up a node with no edges
+void Wfg_init(Wfg_node* node, int kind, int id) {
+    node->kind = kind;
+    node->id = id;
+    node->waitsFor = NULL;
+    node->firstWaiter = node->nextWaiter = node->prevWaiter = NULL;
+    node->left = node->right = node->up = NULL;
+}
+
+// Makes node wait for target
+bool Wfg_wait(Wfg_node* node, Wfg_node* target) {
+    Wfg_release(node);
+    node->waitsFor = target;
+    node->prevWaiter = NULL;
+    node->nextWaiter = target->firstWaiter;
+    if(target->firstWaiter)
+        target->firstWaiter->prevWaiter = node;
+    target->firstWaiter = node;
+    if(findRoot(target) == node)    // target already waits on node
+        return true;
+    link(node, target);
+    return false;
+}
+
+// Removes the outgoing edge of node
+void Wfg_release(Wfg_node* node) {
+    if(node->waitsFor == NULL)
+        return;
+    if(node->prevWaiter)
+        node->prevWaiter->nextWaiter = node->nextWaiter;
+    else
+        node->waitsFor->firstWaiter = node->nextWaiter;
+    if(node->nextWaiter)
+        node->nextWaiter->prevWaiter = node->prevWaiter;
+    node->waitsFor = NULL;
+    Wfg_node* root = findRoot(node);
+    if(root == node)    // Edge closed a cycle and was never linked
+        return;
+    cut(node);
+    // If the root's edge was left out because of a cycle through node, it fits in the forest now
+    if(root->waitsFor && findRoot(root->waitsFor) != root)
+        link(root, root->waitsFor);
+}
+
+// Removes every edge into node
+int Wfg_release_waiters(Wfg_node* node) {
+    int count = 0;
+    while(node->firstWaiter) {
+        Wfg_release(node->firstWaiter);
+        count++;
+    }
+    return count;
+}
+
+// Returns true if node waits, directly or through others, on a cycle
+bool Wfg_deadlocked(Wfg_node* node) {
+    return findRoot(node)->waitsFor != NULL;
+}
@@ -0,0 +1,46 @@
+// Wait-for graph header file
+// Every process and semaphore has a node with at most one outgoing edge: a blocked process waits
+// for the process that must reply or the semaphore it is blocked on, a semaphore with a single
+// holder waits for that holder. The edges form a forest kept in a link-cut tree, so adding or
+// removing an edge and checking it for a cycle takes amortised O(log n) time. Every node also keeps
+// the nodes waiting for it, so the edges into a node can be dropped without searching for them
+#ifndef _WAITGRAPH_H_
+#define _WAITGRAPH_H_
+#include <stdbool.h>
+
+enum wfg_kind{
+    WFG_PROCESS, WFG_SEMAPHORE
+};
+
+typedef struct Wfg_node_s Wfg_node;
+struct Wfg_node_s{
+    int kind;
+    int id;             // PID or semaphore ID
+    Wfg_node* waitsFor; // Outgoing edge, NULL if the node is not waiting
+    Wfg_node* firstWaiter;  // Nodes waiting for this one, linked through nextWaiter/prevWaiter
+    Wfg_node* nextWaiter;
+    Wfg_node* prevWaiter;
+    // Link-cut tree: splay tree children, and the splay parent or path parent
+    Wfg_node* left;
+    Wfg_node* right;
+    Wfg_node* up;
+};
+
+// Sets up a node with no edges
+void Wfg_init(Wfg_node* node, int kind, int id);
+
+// Makes node wait for target, replacing any edge node already had
+// Returns true if the edge closes a cycle (a deadlock); the edge is kept and the cycle can be
+// walked through waitsFor starting at node
+bool Wfg_wait(Wfg_node* node, Wfg_node* target);
+
+// Removes the outgoing edge of node. If that breaks a cycle the remaining edges are relinked
+void Wfg_release(Wfg_node* node);
+
+// Removes every edge into node, returns how many there were
+int Wfg_release_waiters(Wfg_node* node);
+
+// Returns true if node waits, directly or through others, on a cycle
+bool Wfg_deadlocked(Wfg_node* node);
+
+#endif
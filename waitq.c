@@ -0,0 +1,104 @@
+#include "waitq.h"
+#include <stddef.h>
+
+// --------------------------------------- Helper functions ---------------------------------------
+
+static bool before(Waitq_node* a, Waitq_node* b) {
+    return a->key < b->key || (a->key == b->key && a->seq < b->seq);
+}
+
+// Links two heap roots, the later one becomes the first child of the other
+static Waitq_node* meld(Waitq_node* a, Waitq_node* b) {
+    if(a == NULL)
+        return b;
+    if(b == NULL)
+        return a;
+    if(before(b, a)) {
+        Waitq_node* t = a;
+        a = b;
+        b = t;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if(a->child)
+        a->child->prev = b;
+    a->child = b;
+    a->next = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+// Combines a list of siblings into one heap: meld pairs left to right, then fold right to left
+static Waitq_node* mergePairs(Waitq_node* first) {
+    Waitq_node* pairs = NULL;   // Melded pairs in reverse order, linked through next
+    while(first != NULL) {
+        Waitq_node* a = first;
+        Waitq_node* b = a->next;
+        first = b ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if(b)
+            b->next = b->prev = NULL;
+        Waitq_node* pair = meld(a, b);
+        pair->next = pairs;
+        pairs = pair;
+    }
+    Waitq_node* root = NULL;
+    while(pairs != NULL) {
+        Waitq_node* pair = pairs;
+        pairs = pair->next;
+        pair->next = NULL;
+        root = meld(root, pair);
+    }
+    return root;
+}
+
+// ---------------------------------------- Queue functions ---------------------------------------
+
+// Makes wq an empty queue
+void Waitq_init(Waitq* wq) {
+    wq->root = NULL;
+    wq->count = 0;
+    wq->seq = 0;
+}
+
+// Adds node holding item with the given key
+void Waitq_push(Waitq* wq, Waitq_node* node, void* item, long key) {
+    node->key = key;
+    node->seq = wq->seq++;
+    node->item = item;
+    node->child = node->next = node->prev = NULL;
+    wq->root = meld(wq->root, node);
+    wq->count++;
+}
+
+// Returns the first waiter without removing it
+Waitq_node* Waitq_peek(Waitq* wq) {
+    return wq->root;
+}
+
+// Removes and returns the first waiter
+Waitq_node* Waitq_pop(Waitq* wq) {
+    Waitq_node* node = wq->root;
+    if(node != NULL)
+        Waitq_remove(wq, node);
+    return node;
+}
+
+// Removes node from anywhere in the queue
+void Waitq_remove(Waitq* wq, Waitq_node* node) {
+    if(node != wq->root) {  // Cut the node's subtree out of its sibling list
+        if(node->prev->child == node)
+            node->prev->child = node->next;
+        else
+            node->prev->next = node->next;
+        if(node->next)
+            node->next->prev = node->prev;
+        node->next = node->prev = NULL;
+        wq->root = meld(wq->root, mergePairs(node->child));
+    } else
+        wq->root = mergePairs(node->child);
+    if(wq->root)
+        wq->root->prev = NULL;
+    node->child = NULL;
+    wq->count--;
+}
@@ -0,0 +1,47 @@
+// Ordered wait queue header file
+// A pairing heap of waiting items, O(1) insert and O(log n) amortised removal of the first waiter.
+// Waiters with equal keys leave in the order they arrived, so a queue whose keys are all equal is FIFO.
+#ifndef _WAITQ_H_
+#define _WAITQ_H_
+#include <stdbool.h>
+
+enum waitq_order{   // Order in which waiters are woken
+    WAITQ_FIFO,     // Arrival order
+    WAITQ_PRIORITY, // Highest priority first
+    WAITQ_DEADLINE  // Earliest deadline first
+};
+
+typedef struct Waitq_node_s Waitq_node;
+struct Waitq_node_s{
+    long key;           // Smaller keys are woken first
+    unsigned long seq;  // Arrival number, breaks ties between equal keys
+    void* item;         // The waiting item
+    void* pos;          // Where the owner keeps the item outside the heap, not used by the heap
+    Waitq_node* child;  // First child
+    Waitq_node* next;   // Next sibling
+    Waitq_node* prev;   // Previous sibling, or the parent for a first child, NULL for the root
+};
+
+typedef struct Waitq_s Waitq;
+struct Waitq_s{
+    Waitq_node* root;
+    int count;
+    unsigned long seq;
+};
+
+// Makes wq an empty queue
+void Waitq_init(Waitq* wq);
+
+// Adds node holding item with the given key, in O(1)
+void Waitq_push(Waitq* wq, Waitq_node* node, void* item, long key);
+
+// Returns the first waiter without removing it, NULL if the queue is empty
+Waitq_node* Waitq_peek(Waitq* wq);
+
+// Removes and returns the first waiter, NULL if the queue is empty
+Waitq_node* Waitq_pop(Waitq* wq);
+
+// Removes node from anywhere in the queue, node must be in wq
+void Waitq_remove(Waitq* wq, Waitq_node* node);
+
+#endif